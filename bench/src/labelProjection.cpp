@@ -0,0 +1,65 @@
+#include "util/batchProjection.h"
+#include "util/geom.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+static const glm::vec2 screenSize(1024.f, 768.f);
+
+static glm::mat4 makeMVP() {
+    // Tilted view onto a tile spanning 0..1 in model space
+    glm::mat4 proj = glm::perspective(0.8f, screenSize.x / screenSize.y, 0.1f, 100.f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.5f, -1.f, 1.5f),
+                                 glm::vec3(0.5f, 0.5f, 0.f),
+                                 glm::vec3(0.f, 0.f, 1.f));
+    return proj * view;
+}
+
+static std::vector<glm::vec2> makePoints(size_t _count) {
+    std::vector<glm::vec2> points;
+    points.reserve(_count);
+    for (size_t i = 0; i < _count; i++) {
+        points.emplace_back(float(i % 64) / 64.f, float(i / 64) / 64.f);
+    }
+    return points;
+}
+
+static void BM_Tangram_ProjectPointsScalar(benchmark::State& state) {
+    glm::mat4 mvp = makeMVP();
+    auto points = makePoints(state.range(0));
+    std::vector<glm::vec2> screen(points.size());
+
+    while(state.KeepRunning()) {
+        for (size_t i = 0; i < points.size(); i++) {
+            bool clipped = false;
+            screen[i] = worldToScreenSpace(mvp, glm::vec4(points[i], 0.f, 1.f),
+                                           screenSize, clipped);
+        }
+        benchmark::DoNotOptimize(screen.data());
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_Tangram_ProjectPointsScalar)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_Tangram_ProjectPointsBatch(benchmark::State& state) {
+    glm::mat4 mvp = makeMVP();
+    auto points = makePoints(state.range(0));
+    BatchProjection projection;
+
+    while(state.KeepRunning()) {
+        projection.clear();
+        for (auto& p : points) { projection.add(p); }
+        projection.project(mvp, screenSize);
+        benchmark::DoNotOptimize(projection.screenPosition(0));
+    }
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_Tangram_ProjectPointsBatch)->Arg(64)->Arg(1024)->Arg(16384);
+
+BENCHMARK_MAIN();
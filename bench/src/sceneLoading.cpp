@@ -0,0 +1,62 @@
+#include "log.h"
+#include "mockPlatform.h"
+#include "scene/importer.h"
+#include "scene/scene.h"
+#include "scene/sceneBinary.h"
+#include "scene/sceneLoader.h"
+
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Compares loading a scene from YAML with loading it from the SceneBinary
+// that the sceneCompiler tool writes for it
+class SceneLoadingFixture : public benchmark::Fixture {
+public:
+    std::shared_ptr<MockPlatform> platform;
+
+    void SetUp() override {
+        platform = std::make_shared<MockPlatform>();
+        platform->putMockUrlContents(Url("scene.yaml"), MockPlatform::getBytesFromFile("scene.yaml"));
+
+        auto scene = std::make_shared<Scene>(platform, Url("scene.yaml"));
+        Importer importer(scene);
+        platform->putMockUrlContents(Url("scene.tgsb"), SceneBinary::write(importer.applySceneImports(platform)));
+    }
+
+    void load(const char* _url, bool _applyConfig) {
+        auto scene = std::make_shared<Scene>(platform, Url(_url));
+        Importer importer(scene);
+        scene->config() = importer.applySceneImports(platform);
+        if (!scene->config()) {
+            LOGE("Could not load '%s'", _url);
+            return;
+        }
+        if (_applyConfig) {
+            SceneLoader::applyConfig(platform, scene);
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(SceneLoadingFixture, ImportYaml)(benchmark::State& st) {
+    while (st.KeepRunning()) { load("scene.yaml", false); }
+}
+BENCHMARK_DEFINE_F(SceneLoadingFixture, ImportBinary)(benchmark::State& st) {
+    while (st.KeepRunning()) { load("scene.tgsb", false); }
+}
+BENCHMARK_DEFINE_F(SceneLoadingFixture, LoadYaml)(benchmark::State& st) {
+    while (st.KeepRunning()) { load("scene.yaml", true); }
+}
+BENCHMARK_DEFINE_F(SceneLoadingFixture, LoadBinary)(benchmark::State& st) {
+    while (st.KeepRunning()) { load("scene.tgsb", true); }
+}
+
+BENCHMARK_REGISTER_F(SceneLoadingFixture, ImportYaml);
+BENCHMARK_REGISTER_F(SceneLoadingFixture, ImportBinary);
+BENCHMARK_REGISTER_F(SceneLoadingFixture, LoadYaml);
+BENCHMARK_REGISTER_F(SceneLoadingFixture, LoadBinary);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,118 @@
+#include "data/tileSource.h"
+#include "log.h"
+#include "mockPlatform.h"
+#include "scene/importer.h"
+#include "scene/scene.h"
+#include "scene/sceneLoader.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+#include "text/fontContext.h"
+#include "util/mapProjection.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+#include "benchmark/benchmark.h"
+
+using namespace Tangram;
+
+// Builds label heavy tiles on several threads at once, like the TileWorkers
+// do, to measure how much text layout serializes on the FontContext locks.
+// Each iteration loads a fresh scene, so every label is shaped and its glyphs
+// rasterized again instead of being served from the shaping cache and the
+// glyph atlas of the previous iteration. Shaping and rasterization run under
+// the font mutex, only the work after them runs concurrently.
+
+static const TileID tileID = {0,0,10,10,0};
+
+struct ContentionContext {
+
+    MercatorProjection projection;
+
+    std::shared_ptr<MockPlatform> platform = std::make_shared<MockPlatform>();
+
+    std::shared_ptr<Scene> scene;
+    std::shared_ptr<TileSource> source;
+    std::shared_ptr<TileData> tileData;
+
+    bool load(const char* _scenePath, const char* _tilePath) {
+
+        Url sceneUrl(_scenePath);
+        platform->putMockUrlContents(sceneUrl, MockPlatform::getBytesFromFile(_scenePath));
+
+        scene = std::make_shared<Scene>(platform, sceneUrl);
+        Importer importer(scene);
+
+        try {
+            scene->config() = importer.applySceneImports(platform);
+        }
+        catch (const YAML::ParserException& e) {
+            LOGE("Parsing scene config '%s'", e.what());
+            return false;
+        }
+        SceneLoader::applyConfig(platform, scene);
+
+        scene->fontContext()->loadFonts();
+
+        source = *scene->tileSources().begin();
+
+        Tile tile(tileID, projection);
+        auto task = source->createTask(tile.getID());
+        auto& t = dynamic_cast<BinaryTileTask&>(*task);
+        t.rawTileData = std::make_shared<std::vector<char>>(MockPlatform::getBytesFromFile(_tilePath));
+
+        tileData = source->parse(*task, projection);
+
+        return bool(tileData);
+    }
+};
+
+static void BM_Tangram_ConcurrentTextTiles(benchmark::State& state) {
+    const int numThreads = state.range(0);
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+
+        // A new scene per iteration, with an empty shaping cache and glyph atlas
+        auto ctx = std::make_unique<ContentionContext>();
+        if (!ctx->load("scene.yaml", "tile.mvt")) {
+            LOGE("Could not load benchmark scene");
+            state.ResumeTiming();
+            break;
+        }
+
+        // One TileBuilder per thread, as owned by the TileWorkers
+        std::vector<std::unique_ptr<TileBuilder>> builders;
+        for (int i = 0; i < numThreads; i++) {
+            builders.push_back(std::make_unique<TileBuilder>(ctx->scene));
+        }
+
+        state.ResumeTiming();
+
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < numThreads; i++) {
+            // A single build per thread, later builds of the tile would only
+            // hit the shaping cache filled by this one
+            threads.emplace_back([&, i]() {
+                auto tile = builders[i]->build(tileID, *ctx->tileData, *ctx->source);
+                benchmark::DoNotOptimize(tile.get());
+            });
+        }
+        for (auto& thread : threads) { thread.join(); }
+
+        // Scene and builders are released outside of the measured time
+        state.PauseTiming();
+        builders.clear();
+        ctx.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * numThreads);
+}
+BENCHMARK(BM_Tangram_ConcurrentTextTiles)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -3,6 +3,8 @@
 #include "log.h"
 #include "map.h"
 #include "mockPlatform.h"
+#include "scene/dataLayer.h"
+#include "scene/drawRule.h"
 #include "scene/importer.h"
 #include "scene/scene.h"
 #include "scene/sceneLoader.h"
@@ -14,6 +16,7 @@
 #include "text/fontContext.h"
 #include "util/mapProjection.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -113,6 +116,40 @@ BENCHMARK_DEFINE_F(TileLoadingFixture, BuildTest)(benchmark::State& st) {
 
 BENCHMARK_REGISTER_F(TileLoadingFixture, BuildTest);
 
+// Matches and merges the draw rules for all features of the tile without
+// building them, as done for each feature in TileBuilder::applyStyling
+BENCHMARK_DEFINE_F(TileLoadingFixture, MatchRules)(benchmark::State& st) {
+    ctx.parseTile();
+    if (!ctx.tileData) { return; }
+
+    DrawRuleMergeSet ruleSet;
+    size_t matched = 0;
+
+    while (st.KeepRunning()) {
+        for (const auto& datalayer : ctx.scene->layers()) {
+            if (datalayer.source() != ctx.source->name()) { continue; }
+
+            for (const auto& collection : ctx.tileData->layers) {
+                const auto& dlc = datalayer.collections();
+                if (!collection.name.empty() &&
+                    std::find(dlc.begin(), dlc.end(), collection.name) == dlc.end()) {
+                    continue;
+                }
+                for (const auto& feature : collection.features) {
+                    if (!ruleSet.match(feature, datalayer, ctx.styleContext)) { continue; }
+
+                    for (auto& rule : ruleSet.matchedRules()) {
+                        matched += ruleSet.evaluateRuleForContext(rule, ctx.styleContext);
+                    }
+                }
+            }
+        }
+    }
+    benchmark::DoNotOptimize(matched);
+}
+
+BENCHMARK_REGISTER_F(TileLoadingFixture, MatchRules);
+
 
 
 BENCHMARK_MAIN();
@@ -51,6 +51,12 @@ public:
      */
     static int32_t zoomBiasFromTileSize(int32_t tileSize);
 
+    struct CacheStats {
+        size_t bytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
     struct DataSource {
         virtual ~DataSource() {}
 
@@ -63,6 +69,19 @@ public:
 
         virtual void clear() { if (next) next->clear(); }
 
+        /* Use the caches of the DataSource chain @_other, which was built from the same config */
+        virtual void shareCache(DataSource& _other) {
+            if (next && _other.next) { next->shareCache(*_other.next); }
+        }
+
+        /* Adds the size, hits and misses of the caches in this chain to @_stats */
+        virtual void cacheStats(CacheStats& _stats) const {
+            if (next) { next->cacheStats(_stats); }
+        }
+
+        /* Resets the hit and miss counters of the caches in this chain */
+        virtual void resetCacheStats() { if (next) next->resetCacheStats(); }
+
         void setNext(std::unique_ptr<DataSource> _next) {
             next = std::move(_next);
             next->level = level + 1;
@@ -109,6 +128,23 @@ public:
     /* Clears all data associated with this TileSource */
     virtual void clearData();
 
+    /* Use the raw tile data caches of @_other and its raster sources, which must be
+     * loaded from the same config. Sources of different scenes, e.g. those of maps
+     * that render the same scene in parallel, then load each tile only once.
+     * clearData() of either source clears the shared caches.
+     */
+    void shareCache(TileSource& _other);
+
+    /* Adds the size, hits and misses of the raw tile data caches of this TileSource
+     * to @_stats. Hits and misses of shared caches include those of all sharing sources.
+     */
+    void cacheStats(CacheStats& _stats) const;
+
+    void resetCacheStats();
+
+    /* Builds tiles of this TileSource again from the data it already loaded */
+    void rebuildTiles() { m_generation++; }
+
     const std::string& name() const { return m_name; }
 
     virtual void clearRasters();
@@ -78,6 +78,72 @@ struct SceneError {
     Error error;
 };
 
+// Time in milliseconds spent in the stages of loading a scene
+struct SceneTiming {
+    // Fetching and parsing the scene file and its imports
+    float import = 0;
+    // Creating sources, styles and layers from the scene config
+    float config = 0;
+    // Fetching and decoding textures and fonts, once the config was applied.
+    // Scenes loaded with loadScene() do not wait for them and report 0.
+    float resources = 0;
+};
+
+// Distribution of a duration in milliseconds. Percentiles are the upper
+// limits of fixed histogram buckets, which double from 0.25ms.
+struct TimingMetrics {
+    uint64_t count = 0;
+    float mean = 0;
+    float p50 = 0;
+    float p90 = 0;
+    float p99 = 0;
+    float max = 0;
+};
+
+// Runtime state of a Map, see Map::getMetrics()
+struct MapMetrics {
+    // Tiles drawn by the last update, the proxies among them, and tiles
+    // being loaded or waiting for upload budget
+    uint32_t tilesVisible = 0;
+    uint32_t tilesProxy = 0;
+    uint32_t tilesInProgress = 0;
+    uint32_t tilesPendingUpload = 0;
+
+    // Cache of built tiles that left the view
+    uint32_t tileCacheEntries = 0;
+    size_t tileCacheBytes = 0;
+    uint64_t tileCacheHits = 0;
+    uint64_t tileCacheMisses = 0;
+
+    // In-memory caches of raw tile data, summed over the sources of the
+    // current scene. Caches shared through loadSceneFrom() count the hits
+    // and misses of all maps using them.
+    size_t rawCacheBytes = 0;
+    uint64_t rawCacheHits = 0;
+    uint64_t rawCacheMisses = 0;
+
+    // Tile tasks waiting for the worker threads, and the time spent on
+    // decoding and building tiles
+    uint32_t workerQueueSize = 0;
+    TimingMetrics tileDecode;
+    TimingMetrics tileBuild;
+
+    // Labels considered and shown by the last label update, and the time
+    // spent on resolving label collisions
+    uint32_t labels = 0;
+    uint32_t labelsVisible = 0;
+    TimingMetrics labelCollision;
+
+    // Glyph atlas textures in use
+    uint32_t glyphAtlases = 0;
+
+    // Size of all GL buffers and textures in bytes
+    size_t gpuMemory = 0;
+
+    TimingMetrics frameUpdate;
+    TimingMetrics frameRender;
+};
+
 using SceneID = int32_t;
 
 // Function type for a sceneReady callback
@@ -90,6 +156,13 @@ enum class EaseType : char {
     sine,
 };
 
+// Result of Map::renderOffscreen()
+enum class RenderResult : char {
+    complete = 0,   // The whole view was loaded and rendered
+    incomplete,     // Rendered when the timeout passed, parts of the view may be missing
+    failed,         // Nothing could be rendered
+};
+
 class Map {
 
 public:
@@ -99,6 +172,8 @@ public:
     ~Map();
 
     // Load the scene at the given absolute file path asynchronously.
+    // The file can be a YAML scene or a scene binary compiled from one by
+    // the sceneCompiler tool, placed next to it.
     SceneID loadSceneAsync(const std::string& _scenePath,
                            bool _useScenePosition = false,
                            const std::vector<SceneUpdate>& _sceneUpdates = {});
@@ -112,11 +187,19 @@ public:
                                bool _useScenePosition = false,
                                const std::vector<SceneUpdate>& _sceneUpdates = {});
 
-    // Load the scene at the given absolute file path synchronously
+    // Load the scene at the given absolute file path synchronously, like
+    // loadSceneAsync()
     SceneID loadScene(const std::string& _scenePath,
                       bool _useScenePosition = false,
                       const std::vector<SceneUpdate>& sceneUpdates = {});
 
+    // Load the scene that _other loaded last synchronously, without importing
+    // it again. The scene gets its own styles, fonts and GL resources while
+    // its tile sources share the raw tile data cached by those of _other, so
+    // that maps with separate GL contexts can render it in parallel. _other
+    // must not load or update its scene meanwhile.
+    SceneID loadSceneFrom(Map& _other);
+
     // Request updates to the current scene configuration. This reloads the
     // scene with the updated configuration.
     // The SceneUpdate path is a series of yaml keys separated by a '.' and the
@@ -126,9 +209,14 @@ public:
 
     // Set listener for scene load events. The callback receives the SceneID
     // of the loaded scene and SceneError in case loading was not successful.
+    // Scenes loaded asynchronously are ready once their textures and fonts are loaded.
     // The callback may be be called from the main or worker thread.
     void setSceneReadyListener(SceneReadyCallback _onSceneReady);
 
+    // Returns the time spent on the stages of loading the current scene,
+    // e.g. from the callback of setSceneReadyListener()
+    SceneTiming getSceneTiming();
+
     // Set an MBTiles SQLite database file for a DataSource in the scene.
     void setMBTiles(const char* _dataSourceName, const char* _mbtilesFilePath);
 
@@ -166,6 +254,16 @@ public:
     // Each unsigned int corresponds to an RGBA pixel value
     void captureSnapshot(unsigned int* _data);
 
+    // Render the view into an offscreen framebuffer of _width x _height pixels,
+    // without a window. Updates the map until the scene, its fonts and textures
+    // and all tiles in view are loaded, or for at most _timeout seconds, which
+    // blocks the calling thread. The thread must have a current GL context.
+    // _pixels receives the image in the layout of captureSnapshot(); it is
+    // cleared when rendering failed, e.g. when the scene textures or fonts
+    // did not load within _timeout.
+    RenderResult renderOffscreen(int _width, int _height, std::vector<unsigned int>& _pixels,
+                                 float _timeout = 30);
+
     // Set the position of the map view in degrees longitude and latitude; if duration
     // (in seconds) is provided, position eases to the set value over the duration;
     // calling either version of the setter overrides all previous calls
@@ -346,6 +444,27 @@ public:
     // r, g, b must be between 0.0 and 1.0
     void setDefaultBackgroundColor(float r, float g, float b);
 
+    // Set the maximum size of GL buffers and textures in bytes; when exceeded, cached
+    // tiles are evicted and unused glyph atlases released. 0 disables the budget.
+    // The budget and usage are process-wide: the budget applies to the resources
+    // of all Map instances together, and setting it on one Map sets it for all.
+    void setGPUMemoryBudget(size_t _bytes);
+
+    // Returns the size of all GL buffers and textures of all Map instances in bytes
+    size_t getGPUMemoryUsage();
+
+    // Returns counters, sizes and timings of tiles, caches, labels and
+    // frames. Counters and timings accumulate until resetMetrics().
+    MapMetrics getMetrics();
+
+    void resetMetrics();
+
+    // Set a directory for caching linked shader programs between sessions when the
+    // GL driver supports program binaries; an empty path disables the cache.
+    // Applies to programs built after this call. The directory is process-wide:
+    // it applies to the programs of all maps.
+    void setShaderCacheDirectory(const std::string& _directory);
+
     std::shared_ptr<Platform>& getPlatform();
 
 private:
@@ -386,4 +505,18 @@ bool getDebugFlag(DebugFlags _flag);
 // Toggle the boolean state of a debug feature (see debug.h)
 void toggleDebugFlag(DebugFlags _flag);
 
+// Set the width and height of glyph atlas textures and a file for caching glyph
+// distance fields between sessions; an empty path disables the cache.
+// Applies to the scenes of all maps that are loaded after this call.
+void setGlyphAtlasOptions(int _atlasSize, const std::string& _glyphCachePath = "");
+
+// Record the stages of loading each tile and the update and render time of
+// each frame. Recording uses a fixed amount of memory per thread and keeps
+// only the most recent events.
+void setTraceEnabled(bool _enabled);
+
+// Get the recorded events in the Chrome trace event format, as a JSON array
+// that chrome://tracing and Perfetto can open
+std::string getTraceJson();
+
 }
@@ -3,6 +3,7 @@
 #include "tile/tileID.h"
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -21,6 +22,18 @@ class TileTask {
 
 public:
 
+    // Transitions of the task that are timed when tracing is enabled
+    enum class Stage : uint8_t {
+        created,
+        loaded,
+        decoding,
+        decoded,
+        building,
+        built,
+        completed,
+        count,
+    };
+
     TileTask(TileID& _tileId, std::shared_ptr<TileSource> _source, int _subTask);
 
     // No copies
@@ -62,6 +75,11 @@ public:
     int subTaskId() const { return m_subTaskId; }
     bool isSubTask() const { return m_subTaskId >= 0; }
 
+    // running on decoder thread, or on worker thread before process()
+    virtual void decode(const MapProjection& _projection);
+
+    bool isDecoded() const { return m_decoded; }
+
     // running on worker thread
     virtual void process(TileBuilder& _tileBuilder);
 
@@ -82,6 +100,13 @@ public:
 
     void startedLoading() { m_needsLoading = false; }
 
+    // Records the time of _stage and traces the span since the last recorded
+    // stage. Does nothing unless tracing is enabled (see debug/tracer.h).
+    void trace(Stage _stage);
+
+    // Time of _stage in µs on the Tracer's clock, 0 if it was not traced
+    int64_t stageTime(Stage _stage) const { return m_stageTimes[static_cast<size_t>(_stage)]; }
+
 protected:
 
     const TileID m_tileId;
@@ -99,11 +124,17 @@ protected:
     // Tile result, set when tile was  sucessfully created
     std::shared_ptr<Tile> m_tile;
 
+    // Decoded data of the tile, consumed by process()
+    std::shared_ptr<TileData> m_tileData;
+    bool m_decoded = false;
+
     bool m_canceled = false;
     bool m_needsLoading = true;
 
     std::atomic<float> m_priority;
     bool m_proxyState = false;
+
+    int64_t m_stageTimes[static_cast<size_t>(Stage::count)] = {};
 };
 
 class BinaryTileTask : public TileTask {
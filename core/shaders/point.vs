@@ -20,6 +20,14 @@ attribute vec3 a_position;
 attribute vec4 a_outline_color;
 attribute float a_aa_factor;
 
+#ifdef TANGRAM_POINT_INSTANCING
+// Set while drawing instanced quads, see PointStyle
+uniform LOWP int u_instanced;
+attribute vec2 a_corner;
+attribute vec4 a_axes;
+attribute vec4 a_uv_rect;
+#endif
+
 #ifdef TANGRAM_FEATURE_SELECTION
 attribute vec4 a_selection_color;
 varying vec4 v_selection_color;
@@ -48,14 +56,24 @@ void main() {
     }
 #endif
 
+    vec3 position = a_position;
+    vec2 uv = a_uv;
+
+#ifdef TANGRAM_POINT_INSTANCING
+    if (u_instanced == 1) {
+        position = vec3(a_position.xy + a_corner.x * a_axes.xy + a_corner.y * a_axes.zw, 0.0);
+        uv = mix(a_uv_rect.xy, a_uv_rect.zw, a_corner * 0.5 + 0.5);
+    }
+#endif
+
     if (u_sprite_mode == 0) {
-        v_texcoords = sign(a_uv);
-        v_edge = abs(a_uv);
+        v_texcoords = sign(uv);
+        v_edge = abs(uv);
     } else {
-        v_texcoords = a_uv;
+        v_texcoords = uv;
     }
     v_outline_color = a_outline_color;
     v_aa_factor = a_aa_factor;
 
-    gl_Position = vec4(a_position, 1.0);
+    gl_Position = vec4(position, 1.0);
 }
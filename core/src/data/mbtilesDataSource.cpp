@@ -1,5 +1,6 @@
 #include "data/mbtilesDataSource.h"
 
+#include "debug/tracer.h"
 #include "util/asyncWorker.h"
 #include "util/zlibHelper.h"
 #include "log.h"
@@ -153,7 +154,10 @@ bool MBTilesDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb
             auto& task = static_cast<BinaryTileTask&>(*_task);
             task.rawTileData = std::make_shared<std::vector<char>>();
 
-            getTileData(tileId, *task.rawTileData);
+            {
+                TraceScope trace("mbtiles read", "io", tileId);
+                getTileData(tileId, *task.rawTileData);
+            }
 
             if (task.hasData()) {
                 LOGW("loaded tile: %s, %d", tileId.toString().c_str(), task.rawTileData->size());
@@ -1,9 +1,12 @@
 #include "data/memoryCacheDataSource.h"
 
+#include "debug/tracer.h"
 #include "tile/tileHash.h"
 #include "tile/tileID.h"
 #include "log.h"
 
+#include <algorithm>
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <unordered_map>
@@ -25,6 +28,10 @@ struct RawCache {
     int m_usage = 0;
     int m_maxUsage = 0;
 
+    // Read by Map::getMetrics() without taking m_mutex
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+
     bool get(BinaryTileTask& _task) {
 
         if (m_maxUsage <= 0) { return false; }
@@ -39,9 +46,11 @@ struct RawCache {
             m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
             _task.rawTileData = m_cacheList.front().second;
 
+            m_hits++;
             return true;
         }
 
+        m_misses++;
         return false;
     }
     void put(const TileID& tileID, std::shared_ptr<std::vector<char>> rawDataRef) {
@@ -80,15 +89,35 @@ struct RawCache {
         m_cacheList.clear();
         m_usage = 0;
     }
+
+    size_t usage() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::max(m_usage, 0);
+    }
 };
 
 
 MemoryCacheDataSource::MemoryCacheDataSource() :
-    m_cache(std::make_unique<RawCache>()) {
+    m_cache(std::make_shared<RawCache>()) {
 }
 
 MemoryCacheDataSource::~MemoryCacheDataSource() {}
 
+void MemoryCacheDataSource::cacheStats(TileSource::CacheStats& _stats) const {
+    _stats.bytes += m_cache->usage();
+    _stats.hits += m_cache->m_hits;
+    _stats.misses += m_cache->m_misses;
+
+    DataSource::cacheStats(_stats);
+}
+
+void MemoryCacheDataSource::resetCacheStats() {
+    m_cache->m_hits = 0;
+    m_cache->m_misses = 0;
+
+    DataSource::resetCacheStats();
+}
+
 void MemoryCacheDataSource::setCacheSize(size_t _cacheSize) {
     m_cache->m_maxUsage = _cacheSize;
 }
@@ -110,6 +139,7 @@ bool MemoryCacheDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTa
         cacheGet(task);
 
         if (task.hasData()) {
+            Tracer::instant("memory cache hit", "io", task.tileId());
             _cb.func(_task);
             return true;
         }
@@ -139,4 +169,13 @@ void MemoryCacheDataSource::clear() {
     if (next) { next->clear(); }
 }
 
+void MemoryCacheDataSource::shareCache(DataSource& _other) {
+
+    if (auto other = dynamic_cast<MemoryCacheDataSource*>(&_other)) {
+        m_cache = other->m_cache;
+    }
+
+    DataSource::shareCache(_other);
+}
+
 }
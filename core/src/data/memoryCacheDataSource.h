@@ -14,17 +14,23 @@ public:
 
     void clear() override;
 
+    void shareCache(DataSource& _other) override;
+
     /* @_cacheSize: Set size of in-memory cache for tile data in bytes.
      * This cache holds unprocessed tile data for fast recreation of recently used tiles.
      */
     void setCacheSize(size_t _cacheSize);
 
+    void cacheStats(TileSource::CacheStats& _stats) const override;
+
+    void resetCacheStats() override;
+
 private:
     bool cacheGet(BinaryTileTask& _task);
 
     void cachePut(const TileID& _tileID, std::shared_ptr<std::vector<char>> _rawDataRef);
 
-    std::unique_ptr<RawCache> m_cache;
+    std::shared_ptr<RawCache> m_cache;
 
 };
 
@@ -1,5 +1,6 @@
 #include "data/networkDataSource.h"
 
+#include "debug/tracer.h"
 #include "log.h"
 #include "platform.h"
 
@@ -58,10 +59,16 @@ bool NetworkDataSource::loadTileData(std::shared_ptr<TileTask> task, TileTaskCb
         m_urlSubdomainIndex = (m_urlSubdomainIndex + 1) % m_urlSubdomains.size();
     }
 
-    UrlCallback onRequestFinish = [this, callback, task, url](UrlResponse response) mutable {
+    Tracer::Time start = Tracer::isEnabled() ? Tracer::now() : -1;
+
+    UrlCallback onRequestFinish = [this, callback, task, url, start](UrlResponse response) mutable {
 
         removePending(task->tileId(), false);
 
+        if (start >= 0) {
+            Tracer::span("fetch", "io", start, Tracer::now(), task->tileId());
+        }
+
         if (task->isCanceled()) {
             return;
         }
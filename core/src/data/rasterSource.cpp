@@ -1,7 +1,9 @@
 #include "data/rasterSource.h"
 #include "data/propertyItem.h"
 #include "data/tileData.h"
+#include "scene/scene.h"
 #include "tile/tile.h"
+#include "tile/tileBuilder.h"
 #include "tile/tileTask.h"
 #include "util/mapProjection.h"
 #include "platform.h"
@@ -27,7 +29,7 @@ public:
         }
     }
 
-    void process(TileBuilder& _tileBuilder) override {
+    void decode(const MapProjection& _projection) override {
 
         auto source = reinterpret_cast<RasterSource*>(m_source.get());
 
@@ -36,6 +38,19 @@ public:
             m_texture = source->createTexture(*rawTileData);
         }
 
+        if (!isSubTask()) {
+            BinaryTileTask::decode(_projection);
+        } else {
+            m_decoded = true;
+        }
+    }
+
+    void process(TileBuilder& _tileBuilder) override {
+
+        if (!m_decoded) {
+            decode(*_tileBuilder.scene().mapProjection());
+        }
+
         // Create tile geometries
         if (!isSubTask()) {
             BinaryTileTask::process(_tileBuilder);
@@ -76,6 +91,7 @@ RasterSource::RasterSource(const std::string& _name, std::unique_ptr<DataSource>
 
     std::vector<char> data = {};
     m_emptyTexture = std::make_shared<Texture>(data, m_texOptions, m_genMipmap);
+    m_emptyTexture->setMemoryCategory(GPUMemory::rasters);
 }
 
 std::shared_ptr<Texture> RasterSource::createTexture(const std::vector<char>& _rawTileData) {
@@ -84,6 +100,7 @@ std::shared_ptr<Texture> RasterSource::createTexture(const std::vector<char>& _r
     }
 
     auto texture = std::make_shared<Texture>(_rawTileData, m_texOptions, m_genMipmap);
+    texture->setMemoryCategory(GPUMemory::rasters);
 
     return texture;
 }
@@ -11,6 +11,7 @@
 #include "log.h"
 #include "util/geom.h"
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 
@@ -85,6 +86,26 @@ void TileSource::clearData() {
     m_generation++;
 }
 
+void TileSource::shareCache(TileSource& _other) {
+
+    if (m_sources && _other.m_sources) { m_sources->shareCache(*_other.m_sources); }
+
+    size_t count = std::min(m_rasterSources.size(), _other.m_rasterSources.size());
+    for (size_t i = 0; i < count; i++) {
+        m_rasterSources[i]->shareCache(*_other.m_rasterSources[i]);
+    }
+}
+
+void TileSource::cacheStats(CacheStats& _stats) const {
+
+    if (m_sources) { m_sources->cacheStats(_stats); }
+}
+
+void TileSource::resetCacheStats() {
+
+    if (m_sources) { m_sources->resetCacheStats(); }
+}
+
 void TileSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
 
     if (m_sources) {
@@ -3,8 +3,11 @@
 #include "debug/textDisplay.h"
 #include "gl.h"
 #include "gl/glError.h"
+#include "gl/gpuMemory.h"
 #include "gl/primitives.h"
+#include "gl/shaderProgram.h"
 #include "map.h"
+#include "style/style.h"
 #include "tile/tileManager.h"
 #include "tile/tile.h"
 #include "tile/tileCache.h"
@@ -19,9 +22,12 @@
 
 namespace Tangram {
 
-static float s_lastUpdateTime = 0.0;
+// Maps that render on different threads keep separate frame times
+static thread_local float s_lastUpdateTime = 0.0;
 
-static clock_t s_startFrameTime = 0,
+static thread_local GLStats s_frameStats;
+
+static thread_local clock_t s_startFrameTime = 0,
     s_endFrameTime = 0,
     s_startUpdateTime = 0,
     s_endUpdateTime = 0;
@@ -45,6 +51,8 @@ void FrameInfo::endUpdate() {
 
 void FrameInfo::beginFrame() {
 
+    GLStats::recorder().reset();
+
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
         s_startFrameTime = clock();
     }
@@ -52,18 +60,25 @@ void FrameInfo::beginFrame() {
 }
 
 
+const GLStats& FrameInfo::frameStats() {
+    return s_frameStats;
+}
+
 void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManager) {
 
+    // Snapshot before the debug overlay adds its own draw calls
+    s_frameStats = GLStats::recorder();
+
     if (getDebugFlag(DebugFlags::tangram_infos) || getDebugFlag(DebugFlags::tangram_stats)) {
-        static int cpt = 0;
+        thread_local int cpt = 0;
 
-        static std::deque<float> updatetime;
-        static std::deque<float> rendertime;
+        thread_local std::deque<float> updatetime;
+        thread_local std::deque<float> rendertime;
 
         clock_t endCpu = clock();
-        static float timeCpu[60] = { 0 };
-        static float timeUpdate[60] = { 0 };
-        static float timeRender[60] = { 0 };
+        thread_local float timeCpu[60] = { 0 };
+        thread_local float timeUpdate[60] = { 0 };
+        thread_local float timeRender[60] = { 0 };
         timeCpu[cpt] = TIME_TO_MS(s_startFrameTime, endCpu);
 
         if (updatetime.size() >= DEBUG_STATS_MAX_SIZE) {
@@ -117,6 +132,14 @@ void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManag
             debuginfos.push_back("tile cache size:"
                                  + std::to_string(_tileManager.getTileCache()->getMemoryUsage() / 1024) + "kb");
             debuginfos.push_back("tile size:" + std::to_string(memused / 1024) + "kb");
+            debuginfos.push_back("gpu memory:" + std::to_string(GPUMemory::totalUsage() / 1024) + "kb (geometry:"
+                                 + std::to_string(GPUMemory::usage(GPUMemory::geometry) / 1024) + "kb rasters:"
+                                 + std::to_string(GPUMemory::usage(GPUMemory::rasters) / 1024) + "kb glyphs:"
+                                 + std::to_string(GPUMemory::usage(GPUMemory::glyphs) / 1024) + "kb)");
+            debuginfos.push_back("pending uploads:" + std::to_string(_tileManager.pendingUploads()) + " ("
+                                 + std::to_string(_tileManager.uploadBytes() / 1024) + "kb this frame)");
+            debuginfos.push_back("tile meshes drawn:" + std::to_string(Style::cullStats().drawn)
+                                 + " culled:" + std::to_string(Style::cullStats().culled));
             debuginfos.push_back("avg frame cpu time:" + to_string_with_precision(avgTimeCpu, 2) + "ms");
             debuginfos.push_back("avg frame render time:" + to_string_with_precision(avgTimeRender, 2) + "ms");
             debuginfos.push_back("avg frame update time:" + to_string_with_precision(avgTimeUpdate, 2) + "ms");
@@ -125,6 +148,19 @@ void FrameInfo::draw(RenderState& rs, const View& _view, TileManager& _tileManag
                                  + std::to_string(_view.getPosition().y));
             debuginfos.push_back("tilt:" + std::to_string(_view.getPitch() * 57.3) + "deg");
             debuginfos.push_back("pixel scale:" + std::to_string(_view.pixelScale()));
+            if (s_frameStats.totalCalls > 0) {
+                debuginfos.push_back("draw calls:" + std::to_string(s_frameStats.drawCalls));
+                debuginfos.push_back("program binds:" + std::to_string(s_frameStats.programBinds));
+                debuginfos.push_back("uniform sets:" + std::to_string(s_frameStats.uniformSets));
+                debuginfos.push_back("state changes:" + std::to_string(s_frameStats.stateChanges));
+                debuginfos.push_back("uploads:" + std::to_string((s_frameStats.bufferUploadBytes +
+                                                                  s_frameStats.textureUploadBytes) / 1024) + "kb");
+            }
+            auto& builds = ShaderProgram::buildStats();
+            debuginfos.push_back("programs compiled:" + std::to_string(builds.compiled) + " in "
+                                 + to_string_with_precision(builds.compileTime, 2) + "ms");
+            debuginfos.push_back("programs cached:" + std::to_string(builds.cached) + " in "
+                                 + to_string_with_precision(builds.cacheTime, 2) + "ms");
 
             TextDisplay::Instance().draw(rs, debuginfos);
         }
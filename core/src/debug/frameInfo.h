@@ -1,5 +1,7 @@
 #pragma once
 
+#include "gl/glStats.h"
+
 namespace Tangram {
 
 class RenderState;
@@ -14,6 +16,10 @@ struct FrameInfo {
     static void endUpdate();
 
     static void draw(RenderState& rs, const View& _view, TileManager& _tileManager);
+
+    // GL call counters of the last rendered frame, filled when the GL backend
+    // records GLStats (see gl/glStats.h)
+    static const GLStats& frameStats();
 };
 
 }
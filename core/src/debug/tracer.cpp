@@ -0,0 +1,207 @@
+#include "debug/tracer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    Tracer::Time start;
+    // Negative for instant events
+    Tracer::Time duration;
+    TileID tile = NOT_A_TILE;
+};
+
+// Written only by the thread that uses it. 'count' is the number of events
+// ever written, events are stored at count % bufferSize.
+struct TraceBuffer {
+    std::atomic<uint32_t> threadId{0};
+    std::atomic<uint64_t> count{0};
+    // 'count' + 1 while an event is being written, otherwise 'count'
+    std::atomic<uint64_t> writing{0};
+    // Events before this index were cleared
+    std::atomic<uint64_t> begin{0};
+    // Guarded by s_buffersMutex: whether a running thread writes to this
+    // buffer, and otherwise when its thread exited
+    bool inUse = true;
+    uint64_t retired = 0;
+    TraceEvent events[Tracer::bufferSize];
+
+    bool empty() const {
+        return begin.load(std::memory_order_relaxed) >= count.load(std::memory_order_relaxed);
+    }
+};
+
+static std::mutex s_buffersMutex;
+static std::vector<std::shared_ptr<TraceBuffer>> s_buffers;
+static uint32_t s_nextThreadId = 1;
+static uint64_t s_nextRetired = 1;
+
+// Releases the buffer of a thread when the thread exits. The buffer keeps its
+// events for json() until clear(), or until more than maxRetiredBuffers
+// threads exited after it. Only empty buffers are taken over by new threads.
+struct ThreadBufferOwner {
+    std::shared_ptr<TraceBuffer> buffer;
+
+    ~ThreadBufferOwner() {
+        if (!buffer) { return; }
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        buffer->inUse = false;
+        buffer->retired = s_nextRetired++;
+
+        size_t retired = 0;
+        TraceBuffer* oldest = nullptr;
+        for (auto& b : s_buffers) {
+            if (b->inUse || b->empty()) { continue; }
+            retired++;
+            if (!oldest || b->retired < oldest->retired) { oldest = b.get(); }
+        }
+        if (retired > Tracer::maxRetiredBuffers) {
+            // No thread writes to it anymore
+            oldest->begin.store(oldest->count.load(std::memory_order_relaxed),
+                                std::memory_order_relaxed);
+        }
+    }
+};
+
+static TraceBuffer& threadBuffer() {
+    thread_local ThreadBufferOwner owner;
+    if (!owner.buffer) {
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+
+        auto it = std::find_if(s_buffers.begin(), s_buffers.end(),
+                               [](const auto& b) { return !b->inUse && b->empty(); });
+        if (it != s_buffers.end()) {
+            owner.buffer = *it;
+            owner.buffer->inUse = true;
+        } else {
+            owner.buffer = std::make_shared<TraceBuffer>();
+            s_buffers.push_back(owner.buffer);
+        }
+        owner.buffer->threadId.store(s_nextThreadId++, std::memory_order_relaxed);
+    }
+    return *owner.buffer;
+}
+
+static void record(const TraceEvent& _event) {
+    auto& buffer = threadBuffer();
+    uint64_t count = buffer.count.load(std::memory_order_relaxed);
+    // Readers that see the new slot content also see 'writing', see Tracer::json()
+    buffer.writing.store(count + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    buffer.events[count % Tracer::bufferSize] = _event;
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+void Tracer::setEnabled(bool _enabled) {
+    s_enabled.store(_enabled, std::memory_order_relaxed);
+}
+
+Tracer::Time Tracer::now() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Tracer::span(const char* _name, const char* _category, Time _start, Time _end, const TileID& _tile) {
+    if (!isEnabled()) { return; }
+    record({ _name, _category, _start, std::max<Time>(_end - _start, 0), _tile });
+}
+
+void Tracer::instant(const char* _name, const char* _category, const TileID& _tile) {
+    if (!isEnabled()) { return; }
+    record({ _name, _category, now(), -1, _tile });
+}
+
+// Copies slots that their thread may be overwriting at the same time. The
+// caller detects and drops torn copies using TraceBuffer::writing, but the
+// concurrent access itself is a data race to ThreadSanitizer, which is told
+// to ignore it here.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((no_sanitize_thread))
+#endif
+static void copyEvents(const TraceBuffer& _buffer, uint64_t _begin, uint64_t _end,
+                       std::vector<TraceEvent>& _events) {
+    for (uint64_t i = _begin; i < _end; i++) {
+        _events.push_back(_buffer.events[i % Tracer::bufferSize]);
+    }
+}
+
+static void appendEvent(std::string& _out, const TraceEvent& _event, uint32_t _threadId) {
+    _out += "{\"name\":\"";
+    _out += _event.name;
+    _out += "\",\"cat\":\"";
+    _out += _event.category;
+    _out += "\",\"pid\":1,\"tid\":";
+    _out += std::to_string(_threadId);
+    _out += ",\"ts\":";
+    _out += std::to_string(_event.start);
+    if (_event.duration >= 0) {
+        _out += ",\"ph\":\"X\",\"dur\":";
+        _out += std::to_string(_event.duration);
+    } else {
+        _out += ",\"ph\":\"i\",\"s\":\"t\"";
+    }
+    if (_event.tile.z >= 0) {
+        _out += ",\"args\":{\"tile\":\"";
+        _out += std::to_string(_event.tile.z) + "/" + std::to_string(_event.tile.x) + "/" +
+            std::to_string(_event.tile.y);
+        _out += "\"}";
+    }
+    _out += "}";
+}
+
+std::string Tracer::json() {
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        buffers = s_buffers;
+    }
+
+    std::string out = "[";
+    std::vector<TraceEvent> events;
+
+    for (auto& buffer : buffers) {
+        uint64_t end = buffer->count.load(std::memory_order_acquire);
+        uint64_t begin = std::max(buffer->begin.load(std::memory_order_relaxed),
+                                  end > bufferSize ? end - bufferSize : 0);
+
+        uint32_t threadId = buffer->threadId.load(std::memory_order_relaxed);
+
+        events.clear();
+        copyEvents(*buffer, begin, end, events);
+
+        // Skip the events that the thread overwrote or is overwriting meanwhile:
+        // event i is overwritten by event i + bufferSize.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t writing = buffer->writing.load(std::memory_order_relaxed);
+        size_t skip = 0;
+        if (writing > bufferSize + begin) {
+            skip = std::min<size_t>(writing - bufferSize - begin, events.size());
+        }
+
+        for (size_t i = skip; i < events.size(); i++) {
+            if (out.size() > 1) { out += ",\n"; }
+            appendEvent(out, events[i], threadId);
+        }
+    }
+
+    out += "]";
+    return out;
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(s_buffersMutex);
+    for (auto& buffer : s_buffers) {
+        buffer->begin.store(buffer->count.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "tile/tileID.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Tangram {
+
+/*
+ * Tracer records timed spans from any thread into a ring buffer per thread
+ * and writes them as Chrome trace event JSON, which can be opened in
+ * chrome://tracing or Perfetto. Threads only write to their own buffer, so
+ * recording takes no locks. While tracing is disabled every call returns
+ * after reading the enabled flag.
+ *
+ * Names and categories are stored by pointer and must be string literals.
+ */
+struct Tracer {
+
+    // Microseconds since the first use of the Tracer
+    using Time = int64_t;
+
+    // Events kept per thread, older ones are overwritten
+    static constexpr size_t bufferSize = 8192;
+
+    // Exited threads whose events are kept until clear(); the events of
+    // threads that exited before are dropped
+    static constexpr size_t maxRetiredBuffers = 16;
+
+    static void setEnabled(bool _enabled);
+
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    static Time now();
+
+    // Record a span from _start to _end, optionally for a tile
+    static void span(const char* _name, const char* _category, Time _start, Time _end,
+                     const TileID& _tile = NOT_A_TILE);
+
+    // Record an event without duration
+    static void instant(const char* _name, const char* _category, const TileID& _tile = NOT_A_TILE);
+
+    // Events recorded since the last clear() as a JSON array of trace events.
+    // Events that threads overwrite while this runs are left out. Reading
+    // them races with the writing thread by design, see copyEvents().
+    static std::string json();
+
+    // Drop the events recorded so far
+    static void clear();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+// Records a span over the lifetime of the scope when tracing is enabled
+class TraceScope {
+public:
+    TraceScope(const char* _name, const char* _category, const TileID& _tile = NOT_A_TILE)
+        : m_name(_name), m_category(_category), m_tile(_tile),
+          m_start(Tracer::isEnabled() ? Tracer::now() : -1) {}
+
+    ~TraceScope() {
+        if (m_start >= 0 && Tracer::isEnabled()) {
+            Tracer::span(m_name, m_category, m_start, Tracer::now(), m_tile);
+        }
+    }
+
+    // End the current span and start the next one in the scope
+    void next(const char* _name) {
+        if (m_start >= 0 && Tracer::isEnabled()) {
+            auto now = Tracer::now();
+            Tracer::span(m_name, m_category, m_start, now, m_tile);
+            m_start = now;
+        }
+        m_name = _name;
+    }
+
+private:
+    const char* m_name;
+    const char* m_category;
+    TileID m_tile;
+    Tracer::Time m_start;
+};
+
+}
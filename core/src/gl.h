@@ -253,6 +253,12 @@ typedef char            GLchar;
 #define GL_MAX_RENDERBUFFER_SIZE        0x84E8
 #define GL_INVALID_FRAMEBUFFER_OPERATION 0x0506
 
+// OES_get_program_binary
+#define GL_PROGRAM_BINARY_LENGTH        0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS   0x87FE
+// ARB_get_program_binary
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+
 // glext.h
 #define GL_ARRAY_BUFFER                 0x8892
 #define GL_ELEMENT_ARRAY_BUFFER         0x8893
@@ -417,5 +423,17 @@ struct GL {
     static void deleteVertexArrays(GLsizei n, const GLuint *arrays);
     static void genVertexArrays(GLsizei n, GLuint *arrays);
 
+    // program binaries, see Hardware::supportsProgramBinary
+    static void getProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length,
+                                 GLenum *binaryFormat, void *binary);
+    static void programBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+    // Only implemented for desktop GL, the GLES extension has no program parameters
+    static void programParameteri(GLuint program, GLenum pname, GLint value);
+
+    // instanced arrays, see Hardware::supportsInstancedArrays
+    static void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices,
+                                      GLsizei primcount);
+    static void vertexAttribDivisor(GLuint index, GLuint divisor);
+
 };
 }
@@ -39,7 +39,7 @@ public:
         //m_batches.clear();
     }
 
-    size_t numberOfVertices() const { return m_vertices.size(); }
+    size_t numberOfVertices() const { return m_nVertices; }
 
     void upload(RenderState& rs) override;
 
@@ -56,6 +56,8 @@ public:
 private:
 
     std::vector<T> m_vertices;
+    // Vertices in the vertex buffer, swapped with m_vertices on upload
+    std::vector<T> m_uploaded;
     Vao m_vaos;
 };
 
@@ -67,10 +69,16 @@ void DynamicQuadMesh<T>::upload(RenderState& rs) {
     // Generate vertex buffer, if needed
     if (m_glVertexBuffer == 0) {
         GL::genBuffers(1, &m_glVertexBuffer);
+        m_uploaded.clear();
     }
 
-    MeshBase::subDataUpload(rs, reinterpret_cast<GLbyte*>(m_vertices.data()));
+    // Labels of a still view write the same vertices in every update, only
+    // upload the vertices that changed since the last upload
+    MeshBase::subDataUploadChanged(rs, reinterpret_cast<GLbyte*>(m_vertices.data()),
+                                   reinterpret_cast<const GLbyte*>(m_uploaded.data()),
+                                   m_uploaded.size());
 
+    m_uploaded.swap(m_vertices);
     m_isUploaded = true;
 }
 
@@ -1,6 +1,7 @@
 #include "gl/framebuffer.h"
 
 #include "gl/glError.h"
+#include "gl/gpuMemory.h"
 #include "gl/primitives.h"
 #include "gl/renderState.h"
 #include "gl/hardware.h"
@@ -109,6 +110,7 @@ void FrameBuffer::init(RenderState& _rs) {
         GL::bindRenderbuffer(GL_RENDERBUFFER, m_glColorRenderBufferHandle);
         GL::renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8_OES,
                                 m_width, m_height);
+        m_renderBufferBytes += size_t(m_width) * m_height * 4;
 
         GL::framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
                                     GL_RENDERBUFFER, m_glColorRenderBufferHandle);
@@ -120,6 +122,7 @@ void FrameBuffer::init(RenderState& _rs) {
         };
 
         m_texture = std::make_unique<Texture>(m_width, m_height, options);
+        m_texture->setMemoryCategory(GPUMemory::framebuffers);
         m_texture->update(_rs, 0);
 
         GL::framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
@@ -132,6 +135,7 @@ void FrameBuffer::init(RenderState& _rs) {
         GL::bindRenderbuffer(GL_RENDERBUFFER, m_glDepthRenderBufferHandle);
         GL::renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16,
                                 m_width, m_height);
+        m_renderBufferBytes += size_t(m_width) * m_height * 2;
 
         GL::framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
                                     GL_RENDERBUFFER, m_glDepthRenderBufferHandle);
@@ -164,6 +168,8 @@ void FrameBuffer::init(RenderState& _rs) {
         m_valid = true;
     }
 
+    GPUMemory::update(GPUMemory::framebuffers, 0, m_renderBufferBytes);
+
     m_disposer = Disposer(_rs);
 }
 
@@ -176,6 +182,8 @@ FrameBuffer::~FrameBuffer() {
 
         GL::deleteFramebuffers(1, &glHandle);
     });
+
+    GPUMemory::update(GPUMemory::framebuffers, m_renderBufferBytes, 0);
 }
 
 void FrameBuffer::drawDebug(RenderState& _rs, glm::vec2 _dim) {
@@ -66,6 +66,9 @@ private:
 
     int m_height;
 
+    // Size of the render buffer storage reported to GPUMemory
+    size_t m_renderBufferBytes = 0;
+
 };
 
 }
@@ -0,0 +1,10 @@
+#include "gl/glStats.h"
+
+namespace Tangram {
+
+GLStats& GLStats::recorder() {
+    thread_local GLStats s_recorder;
+    return s_recorder;
+}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Tangram {
+
+/* Counters for GL calls, state changes and uploaded bytes.
+ *
+ * GL backends that are built for instrumentation, like the recording backend
+ * used by tests and benchmarks, add to GLStats::recorder(). FrameInfo takes a
+ * snapshot of it for each rendered frame. Each thread records into its own
+ * counters, so that maps rendering on separate GL threads count separately.
+ */
+struct GLStats {
+
+    uint32_t drawCalls = 0;
+    uint32_t drawnVertices = 0;
+
+    uint32_t programBinds = 0;
+    uint32_t uniformSets = 0;
+
+    uint32_t textureBinds = 0;
+    uint32_t textureUnitSwitches = 0;
+    uint32_t bufferBinds = 0;
+    uint32_t vertexArrayBinds = 0;
+    uint32_t framebufferBinds = 0;
+
+    // Enable/disable, blend, depth, stencil, color mask, culling and viewport changes
+    uint32_t stateChanges = 0;
+
+    uint32_t bufferUploads = 0;
+    uint64_t bufferUploadBytes = 0;
+
+    uint32_t textureUploads = 0;
+    uint64_t textureUploadBytes = 0;
+
+    uint32_t totalCalls = 0;
+
+    void reset() { *this = GLStats(); }
+
+    // The counters that the current GL backend records into
+    static GLStats& recorder();
+};
+
+}
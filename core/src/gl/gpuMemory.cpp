@@ -0,0 +1,44 @@
+#include "gl/gpuMemory.h"
+
+#include <atomic>
+
+namespace Tangram {
+
+static std::atomic<int64_t> s_usage[GPUMemory::count];
+static std::atomic<size_t> s_budget(0);
+
+void GPUMemory::update(Category _category, size_t _previous, size_t _current) {
+    if (_previous == _current) { return; }
+    s_usage[_category] += int64_t(_current) - int64_t(_previous);
+}
+
+size_t GPUMemory::usage(Category _category) {
+    int64_t usage = s_usage[_category].load();
+    return usage > 0 ? size_t(usage) : 0;
+}
+
+size_t GPUMemory::totalUsage() {
+    size_t sum = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        sum += usage(Category(i));
+    }
+    return sum;
+}
+
+void GPUMemory::setBudget(size_t _bytes) {
+    s_budget = _bytes;
+}
+
+size_t GPUMemory::budget() {
+    return s_budget.load();
+}
+
+size_t GPUMemory::overBudget() {
+    size_t limit = budget();
+    if (limit == 0) { return 0; }
+
+    size_t total = totalUsage();
+    return total > limit ? total - limit : 0;
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Tangram {
+
+/* GPUMemory keeps track of the storage of GL buffers, textures and render
+ * buffers by what they are used for.
+ *
+ * Owners of GL resources report the size of the storage they specify and
+ * release it when they are destroyed. Counters are atomic, so usage can be
+ * queried from any thread. When a budget is set, Map evicts cached tiles and
+ * releases unused glyph atlases while the total usage exceeds it.
+ */
+struct GPUMemory {
+
+    enum Category : uint8_t {
+        geometry = 0,   // Tile, marker and label meshes
+        rasters,        // Raster tile textures
+        textures,       // Scene textures and sprites
+        glyphs,         // Glyph atlases
+        framebuffers,   // Render targets
+        count,
+    };
+
+    // Change the storage recorded for _category from _previous to _current bytes
+    static void update(Category _category, size_t _previous, size_t _current);
+
+    static size_t usage(Category _category);
+
+    static size_t totalUsage();
+
+    // Maximum total usage; 0 disables the budget
+    static void setBudget(size_t _bytes);
+
+    static size_t budget();
+
+    // Returns the number of bytes the total usage exceeds the budget by
+    static size_t overBudget();
+
+};
+
+}
@@ -5,6 +5,7 @@
 #include "platform.h"
 
 #include <cstring>
+#include <mutex>
 #include <sstream>
 #include <algorithm>
 #include <iterator>
@@ -16,17 +17,35 @@ bool supportsMapBuffer = false;
 bool supportsVAOs = false;
 bool supportsTextureNPOT = false;
 bool supportsGLRGBA8OES = false;
+bool supportsProgramBinary = false;
+bool supportsInstancedArrays = false;
 
 uint32_t maxTextureSize = 0;
 uint32_t maxCombinedTextureUnits = 0;
 static char* s_glExtensions;
 
+// Serializes loading from the GL contexts of several render threads
+static std::mutex s_loadMutex;
+
 bool isAvailable(std::string _extension) {
     return bool(s_glExtensions)
       ? strstr(s_glExtensions, _extension.c_str()) != nullptr
       : false;
 }
 
+bool hasExtension(const std::string& _extension) {
+    if (!s_glExtensions || _extension.empty()) { return false; }
+
+    // Match whole names only, vendor variants share parts of their names
+    size_t length = _extension.size();
+    for (const char* start = s_glExtensions; (start = strstr(start, _extension.c_str())); start += length) {
+        bool atStart = start == s_glExtensions || start[-1] == ' ';
+        bool atEnd = start[length] == ' ' || start[length] == '\0';
+        if (atStart && atEnd) { return true; }
+    }
+    return false;
+}
+
 void printAvailableExtensions() {
     if (s_glExtensions == NULL) {
         LOGW("Extensions string is NULL");
@@ -45,6 +64,8 @@ void printAvailableExtensions() {
 }
 
 void loadExtensions() {
+    std::lock_guard<std::mutex> lock(s_loadMutex);
+
     s_glExtensions = (char*) GL::getString(GL_EXTENSIONS);
 
     if (s_glExtensions == NULL) {
@@ -56,6 +77,10 @@ void loadExtensions() {
     supportsVAOs = isAvailable("vertex_array_object");
     supportsTextureNPOT = isAvailable("texture_non_power_of_two");
     supportsGLRGBA8OES = isAvailable("rgb8_rgba8");
+    // Set by initGLExtensions() once the platform resolved the program binary and
+    // instanced draw functions
+    supportsProgramBinary = false;
+    supportsInstancedArrays = false;
 
     LOG("Driver supports map buffer: %d", supportsMapBuffer);
     LOG("Driver supports vaos: %d", supportsVAOs);
@@ -64,9 +89,14 @@ void loadExtensions() {
 
     // find extension symbols if needed
     initGLExtensions();
+
+    LOG("Driver supports program binaries: %d", supportsProgramBinary);
+    LOG("Driver supports instanced arrays: %d", supportsInstancedArrays);
 }
 
 void loadCapabilities() {
+    std::lock_guard<std::mutex> lock(s_loadMutex);
+
     int val;
     GL::getIntegerv(GL_MAX_TEXTURE_SIZE, &val);
     maxTextureSize = val;
@@ -74,6 +104,12 @@ void loadCapabilities() {
     GL::getIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &val);
     maxCombinedTextureUnits = val;
 
+    if (supportsProgramBinary) {
+        // Drivers may expose the extension without any binary format
+        GL::getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &val);
+        supportsProgramBinary = val > 0;
+    }
+
     LOG("Hardware max texture size %d", maxTextureSize);
     LOG("Hardware max combined texture units %d", maxCombinedTextureUnits);
 }
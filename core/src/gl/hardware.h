@@ -9,12 +9,18 @@ extern bool supportsMapBuffer;
 extern bool supportsVAOs;
 extern bool supportsTextureNPOT;
 extern bool supportsGLRGBA8OES;
+extern bool supportsProgramBinary;
+extern bool supportsInstancedArrays;
 extern uint32_t maxTextureSize;
 extern uint32_t maxCombinedTextureUnits;
 
+// Load the flags above from the current GL context. Loads from several threads are
+// serialized, but they must finish before any thread renders with the flags.
 void loadCapabilities();
 void loadExtensions();
 bool isAvailable(std::string _extension);
+// Returns whether the extension with exactly this name, e.g. "GL_EXT_instanced_arrays", is available
+bool hasExtension(const std::string& _extension);
 void printAvailableExtensions();
 
 }
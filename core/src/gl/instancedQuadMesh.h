@@ -0,0 +1,119 @@
+#pragma once
+
+#include "gl/mesh.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
+#include "gl/vertexLayout.h"
+
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+/*
+ * Dynamic mesh of quads that holds one record of type T per quad. Each
+ * record is drawn as an instance of the static quad from
+ * RenderState::getQuadCornerBuffer, so that the shader gets the corner of
+ * the quad in "a_corner" and the instance attributes for all four vertices.
+ * Only usable when Hardware::supportsInstancedArrays is set, DynamicQuadMesh
+ * is the fallback.
+ */
+template<class T>
+class InstancedQuadMesh : public StyledMesh, protected MeshBase {
+
+public:
+
+    InstancedQuadMesh(std::shared_ptr<VertexLayout> _instanceLayout, GLenum _drawMode)
+        : MeshBase(_instanceLayout, _drawMode, GL_DYNAMIC_DRAW) {
+    }
+
+    bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true) override {
+        return drawRange(rs, _shader, 0, m_nVertices);
+    }
+
+    bool drawRange(RenderState& rs, ShaderProgram& shader, size_t instancePos, size_t instanceCount);
+
+    size_t bufferSize() const override {
+        return MeshBase::bufferSize();
+    }
+
+    void clear() {
+        // Clear instances for next frame
+        m_nVertices = 0;
+        m_isUploaded = false;
+        m_instances.clear();
+    }
+
+    size_t numberOfInstances() const { return m_nVertices; }
+
+    void upload(RenderState& rs) override;
+
+    // Reserves space for one quad and returns pointer
+    // into m_instances to write its instance record.
+    T* pushInstance() {
+        m_nVertices += 1;
+        m_instances.emplace_back();
+        return &m_instances.back();
+    }
+
+    static VertexLayout& cornerLayout() {
+        static VertexLayout layout({{"a_corner", 2, GL_FLOAT, false, 0}});
+        return layout;
+    }
+
+private:
+
+    std::vector<T> m_instances;
+    // Instances in the vertex buffer, swapped with m_instances on upload
+    std::vector<T> m_uploaded;
+};
+
+template<class T>
+void InstancedQuadMesh<T>::upload(RenderState& rs) {
+
+    if (m_nVertices == 0 || m_isUploaded) { return; }
+
+    // Generate vertex buffer, if needed
+    if (m_glVertexBuffer == 0) {
+        GL::genBuffers(1, &m_glVertexBuffer);
+        m_uploaded.clear();
+    }
+
+    MeshBase::subDataUploadChanged(rs, reinterpret_cast<GLbyte*>(m_instances.data()),
+                                   reinterpret_cast<const GLbyte*>(m_uploaded.data()),
+                                   m_uploaded.size());
+
+    m_uploaded.swap(m_instances);
+    m_isUploaded = true;
+}
+
+template<class T>
+bool InstancedQuadMesh<T>::drawRange(RenderState& rs, ShaderProgram& shader,
+                                     size_t instancePos, size_t instanceCount) {
+
+    if (instanceCount == 0 || instancePos + instanceCount > m_nVertices) { return false; }
+
+    // Enable shader program
+    if (!shader.use(rs)) { return false; }
+
+    rs.vertexBuffer(rs.getQuadCornerBuffer());
+    cornerLayout().enable(rs, shader, 0);
+
+    rs.vertexBuffer(m_glVertexBuffer);
+    m_vertexLayout->enable(rs, shader, instancePos * m_vertexLayout->getStride());
+    m_vertexLayout->setDivisor(shader, 1);
+
+    rs.indexBuffer(rs.getQuadIndexBuffer());
+
+    GL::drawElementsInstanced(m_drawMode, 6, GL_UNSIGNED_SHORT, 0, instanceCount);
+
+    // The attribute locations are shared with the per-vertex meshes drawn
+    // by the same program, reset them to their default state
+    m_vertexLayout->setDivisor(shader, 0);
+    m_vertexLayout->disable(rs, shader);
+    cornerLayout().disable(rs, shader);
+
+    return true;
+}
+
+}
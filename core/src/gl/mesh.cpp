@@ -53,6 +53,8 @@ MeshBase::~MeshBase() {
         vaos.dispose();
     });
 
+    setGPUBytes(0);
+
 
     if (m_glVertexData) {
         delete[] m_glVertexData;
@@ -117,9 +119,45 @@ void MeshBase::subDataUpload(RenderState& rs, GLbyte* _data) {
         GL::bufferData(GL_ARRAY_BUFFER, vertexBytes, data, m_hint);
     }
 
+    setGPUBytes(vertexBytes + (m_glIndexBuffer ? m_nIndices * sizeof(GLushort) : 0));
+
     m_dirty = false;
 }
 
+void MeshBase::subDataUploadChanged(RenderState& rs, GLbyte* _data, const GLbyte* _previous,
+                                    size_t _previousVertices) {
+
+    if (!_previous || _previousVertices != m_nVertices) {
+        subDataUpload(rs, _data);
+        return;
+    }
+
+    size_t stride = m_vertexLayout->getStride();
+
+    auto changed = [&](size_t _vertex) {
+        return std::memcmp(_data + _vertex * stride, _previous + _vertex * stride, stride) != 0;
+    };
+
+    size_t first = 0;
+    while (first < m_nVertices && !changed(first)) { first++; }
+
+    if (first == m_nVertices) { return; }
+
+    size_t last = m_nVertices - 1;
+    while (last > first && !changed(last)) { last--; }
+
+    size_t count = last - first + 1;
+
+    if (count > m_nVertices / 2) {
+        // Orphaning the whole buffer does not wait for draws that still use it
+        subDataUpload(rs, _data);
+        return;
+    }
+
+    rs.vertexBuffer(m_glVertexBuffer);
+    GL::bufferSubData(GL_ARRAY_BUFFER, first * stride, count * stride, _data + first * stride);
+}
+
 void MeshBase::upload(RenderState& rs) {
 
     // Generate vertex buffer, if needed
@@ -151,6 +189,8 @@ void MeshBase::upload(RenderState& rs) {
         m_glIndexData = nullptr;
     }
 
+    setGPUBytes(bufferSize());
+
     m_disposer = Disposer(rs);
 
     m_isUploaded = true;
@@ -228,6 +268,51 @@ size_t MeshBase::bufferSize() const {
     return m_nVertices * m_vertexLayout->getStride() + m_nIndices * sizeof(GLushort);
 }
 
+bool MeshBase::dropZeroAttrib(const std::string& _attribName) {
+
+    if (!m_glVertexData || m_isUploaded) { return false; }
+
+    size_t attribOffset = 0, attribSize = 0;
+    for (auto& attrib : m_vertexLayout->getAttribs()) {
+        if (attrib.name == _attribName) {
+            attribOffset = attrib.offset;
+            attribSize = VertexLayout::getAttribSize(attrib);
+            break;
+        }
+    }
+    if (attribSize == 0) { return false; }
+
+    size_t stride = m_vertexLayout->getStride();
+
+    for (size_t i = 0; i < m_nVertices; i++) {
+        const GLbyte* value = m_glVertexData + i * stride + attribOffset;
+        for (size_t b = 0; b < attribSize; b++) {
+            if (value[b] != 0) { return false; }
+        }
+    }
+
+    auto layout = m_vertexLayout->without(_attribName);
+    size_t newStride = layout->getStride();
+    size_t tail = stride - attribOffset - attribSize;
+
+    GLbyte* data = new GLbyte[m_nVertices * newStride];
+
+    for (size_t i = 0; i < m_nVertices; i++) {
+        const GLbyte* src = m_glVertexData + i * stride;
+        GLbyte* dst = data + i * newStride;
+
+        std::memcpy(dst, src, attribOffset);
+        std::memcpy(dst + attribOffset, src + attribOffset + attribSize, tail);
+    }
+
+    delete[] m_glVertexData;
+    m_glVertexData = data;
+    m_vertexLayout = layout;
+    m_droppedAttrib = true;
+
+    return true;
+}
+
 // Add indices by collecting them into batches to draw as much as
 // possible in one draw call.  The indices must be shifted by the
 // number of vertices that are present in the current batch.
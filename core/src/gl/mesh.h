@@ -2,6 +2,7 @@
 
 #include "gl.h"
 #include "gl/disposer.h"
+#include "gl/gpuMemory.h"
 #include "gl/vertexLayout.h"
 #include "gl/vao.h"
 #include "style/style.h"
@@ -66,6 +67,14 @@ public:
      */
     void subDataUpload(RenderState& rs, GLbyte* _data = nullptr);
 
+    /*
+     * Upload _data like subDataUpload, when the vertex buffer holds
+     * _previousVertices vertices of _previous only the range of vertices
+     * that changed is uploaded
+     */
+    void subDataUploadChanged(RenderState& rs, GLbyte* _data, const GLbyte* _previous,
+                              size_t _previousVertices);
+
     /*
      * Renders the geometry in this mesh using the ShaderProgram _shader; if
      * geometry has not already been uploaded it will be uploaded at this point
@@ -74,6 +83,14 @@ public:
 
     size_t bufferSize() const;
 
+    /*
+     * Drop the attribute _attribName from the compiled vertex data when it is
+     * zero in all vertices; the mesh then uses a layout without it. Must be
+     * called between compile and upload, vertices cannot be updated after the
+     * attribute was dropped. Returns true when the attribute was dropped.
+     */
+    bool dropZeroAttrib(const std::string& _attribName);
+
 protected:
 
     // Used in draw for legth and offsets: sumIndices, sumVertices
@@ -101,12 +118,21 @@ protected:
     bool m_isUploaded;
     bool m_isCompiled;
     bool m_dirty;
+    bool m_droppedAttrib = false;
 
     GLsizei m_dirtySize;
     GLintptr m_dirtyOffset;
 
     Disposer m_disposer;
 
+    // Size of the buffer storage reported to GPUMemory
+    size_t m_gpuBytes = 0;
+
+    void setGPUBytes(size_t _bytes) {
+        GPUMemory::update(GPUMemory::geometry, m_gpuBytes, _bytes);
+        m_gpuBytes = _bytes;
+    }
+
     size_t compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>& _offsets,
                           const std::vector<uint16_t>& _indices, size_t _offset);
 
@@ -152,6 +178,12 @@ public:
         return MeshBase::draw(rs, shader, useVao);
     }
 
+    bool isSelectable() const override {
+        return m_vertexLayout->hasAttrib("a_selection_color");
+    }
+
+    using MeshBase::dropZeroAttrib;
+
     void compile(const std::vector<MeshData<T>>& _meshes);
 
     void compile(const MeshData<T>& _mesh);
@@ -250,6 +282,10 @@ void Mesh<T>::updateAttribute(Range _vertexRange, const A& _newAttributeValue,
     if (_vertexRange.start < 0 || _vertexRange.length < 1) {
         return;
     }
+    if (m_droppedAttrib) {
+        // Vertex data does not match T anymore
+        return;
+    }
     if (size_t(_vertexRange.start + _vertexRange.length) > m_nVertices) {
         //LOGW("Invalid range");
         return;
@@ -283,6 +319,10 @@ void Mesh<T>::updateVertices(Range _vertexRange, const T& _newVertexValue) {
     if (_vertexRange.start + _vertexRange.length > int(m_nVertices)) {
         return;
     }
+    if (m_droppedAttrib) {
+        // Vertex data does not match T anymore
+        return;
+    }
 
 
     size_t start = _vertexRange.start * tSize;
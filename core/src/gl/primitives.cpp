@@ -19,18 +19,20 @@ namespace Tangram {
 
 namespace Primitives {
 
-static bool s_initialized;
-static std::unique_ptr<ShaderProgram> s_shader;
-static std::unique_ptr<VertexLayout> s_layout;
+// GL objects belong to the context of the thread that uses them, so every
+// render thread gets its own
+thread_local bool s_initialized;
+thread_local std::unique_ptr<ShaderProgram> s_shader;
+thread_local std::unique_ptr<VertexLayout> s_layout;
 
-static UniformLocation s_uColor{"u_color"};
-static UniformLocation s_uProj{"u_proj"};
+thread_local UniformLocation s_uColor{"u_color"};
+thread_local UniformLocation s_uProj{"u_proj"};
 
 
-static std::unique_ptr<ShaderProgram> s_textureShader;
-static std::unique_ptr<VertexLayout> s_textureLayout;
+thread_local std::unique_ptr<ShaderProgram> s_textureShader;
+thread_local std::unique_ptr<VertexLayout> s_textureLayout;
 
-static UniformLocation s_uTextureProj{"u_proj"};
+thread_local UniformLocation s_uTextureProj{"u_proj"};
 
 void init() {
 
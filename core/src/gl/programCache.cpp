@@ -0,0 +1,182 @@
+#include "gl/programCache.h"
+
+#include "gl/hardware.h"
+#include "log.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+static const char cache_magic[4] = { 'T', 'G', 'P', 'B' };
+static const uint32_t cache_version = 1;
+
+static std::mutex s_directoryMutex;
+static std::string s_directory;
+
+// 64 bit FNV-1a, stable across platforms and runs
+static void fnv1a(uint64_t& _hash, const void* _data, size_t _length) {
+    auto* bytes = static_cast<const unsigned char*>(_data);
+    for (size_t i = 0; i < _length; i++) {
+        _hash ^= bytes[i];
+        _hash *= 1099511628211ull;
+    }
+}
+
+static void hashGLString(uint64_t& _hash, GLenum _name) {
+    auto* str = reinterpret_cast<const char*>(GL::getString(_name));
+    if (str) { fnv1a(_hash, str, std::strlen(str)); }
+    // Separator, so that moving characters between strings changes the hash
+    fnv1a(_hash, "\n", 1);
+}
+
+static std::string cachePath(uint64_t _key) {
+    std::lock_guard<std::mutex> lock(s_directoryMutex);
+    if (s_directory.empty()) { return ""; }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(_key));
+
+    if (s_directory.back() == '/') { return s_directory + name; }
+    return s_directory + "/" + name;
+}
+
+void ProgramCache::setDirectory(const std::string& _path) {
+    std::lock_guard<std::mutex> lock(s_directoryMutex);
+    s_directory = _path;
+}
+
+bool ProgramCache::enabled() {
+    if (!Hardware::supportsProgramBinary) { return false; }
+
+    std::lock_guard<std::mutex> lock(s_directoryMutex);
+    return !s_directory.empty();
+}
+
+uint64_t ProgramCache::key(const std::string& _vertSrc, const std::string& _fragSrc) {
+
+    uint64_t hash = 14695981039346656037ull;
+
+    hashGLString(hash, GL_VENDOR);
+    hashGLString(hash, GL_RENDERER);
+    hashGLString(hash, GL_VERSION);
+
+    uint64_t length = _vertSrc.size();
+    fnv1a(hash, &length, sizeof(length));
+    fnv1a(hash, _vertSrc.data(), _vertSrc.size());
+    fnv1a(hash, _fragSrc.data(), _fragSrc.size());
+
+    return hash;
+}
+
+GLuint ProgramCache::load(uint64_t _key) {
+
+    std::string path = cachePath(_key);
+    if (path.empty()) { return 0; }
+
+    std::vector<char> binary;
+    uint32_t format = 0;
+
+    {
+        std::ifstream file(path, std::ifstream::binary | std::ifstream::ate);
+        if (!file.is_open()) { return 0; }
+
+        std::streamoff fileSize = file.tellg();
+        file.seekg(0);
+
+        char magic[4];
+        uint32_t version = 0, length = 0;
+
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&format), sizeof(format));
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+        // The length must fit the file, it is not allocated otherwise
+        if (file && std::memcmp(magic, cache_magic, sizeof(magic)) == 0 &&
+            version == cache_version && length > 0 && length <= fileSize - file.tellg()) {
+            binary.resize(length);
+            file.read(binary.data(), length);
+        }
+        if (!file || binary.empty()) {
+            LOGW("Ignoring invalid program binary: %s", path.c_str());
+            binary.clear();
+        }
+    }
+
+    if (binary.empty()) {
+        std::remove(path.c_str());
+        return 0;
+    }
+
+    GLuint program = GL::createProgram();
+    GL::programBinary(program, format, binary.data(), binary.size());
+
+    GLint isLinked = GL_FALSE;
+    GL::getProgramiv(program, GL_LINK_STATUS, &isLinked);
+
+    if (isLinked == GL_FALSE) {
+        // Usually a driver update that kept its version string
+        LOGD("Driver rejected program binary: %s", path.c_str());
+        GL::deleteProgram(program);
+        std::remove(path.c_str());
+        return 0;
+    }
+
+    return program;
+}
+
+bool ProgramCache::store(uint64_t _key, GLuint _program) {
+
+    std::string path = cachePath(_key);
+    if (path.empty()) { return false; }
+
+    GLint length = 0;
+    GL::getProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) { return false; }
+
+    std::vector<char> binary(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    GL::getProgramBinary(_program, length, &written, &format, binary.data());
+    if (written <= 0) { return false; }
+
+    // Write to a temporary file first so that a concurrent reader never sees
+    // a partially written binary
+    std::string tmpPath = path + ".tmp";
+
+    {
+        std::ofstream file(tmpPath, std::ofstream::binary | std::ofstream::trunc);
+        if (!file.is_open()) {
+            LOGW("Cannot write program binary: %s", tmpPath.c_str());
+            return false;
+        }
+
+        uint32_t binaryFormat = format;
+        uint32_t binaryLength = written;
+
+        file.write(cache_magic, sizeof(cache_magic));
+        file.write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+        file.write(reinterpret_cast<const char*>(&binaryFormat), sizeof(binaryFormat));
+        file.write(reinterpret_cast<const char*>(&binaryLength), sizeof(binaryLength));
+        file.write(binary.data(), binaryLength);
+
+        if (!file) {
+            LOGW("Failed writing program binary: %s", tmpPath.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LOGW("Failed replacing program binary: %s", path.c_str());
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "gl.h"
+
+#include <cstdint>
+#include <string>
+
+namespace Tangram {
+
+/* ProgramCache keeps linked program binaries in a directory, so that shader
+ * programs built in a previous session, or before a context loss, skip
+ * compiling and linking.
+ *
+ * Files are named by a hash of the expanded vertex and fragment source and of
+ * the GL vendor, renderer and version strings. Binaries that the driver
+ * rejects are removed and the program is built from source again. Only used
+ * when Hardware::supportsProgramBinary is set; load() and store() must be
+ * called on the GL thread.
+ */
+class ProgramCache {
+
+public:
+
+    // Directory for cached binaries; an empty path disables the cache
+    static void setDirectory(const std::string& _path);
+
+    static bool enabled();
+
+    static uint64_t key(const std::string& _vertSrc, const std::string& _fragSrc);
+
+    // Returns a linked program for _key or 0 when none is cached or the
+    // driver rejects the cached binary
+    static GLuint load(uint64_t _key);
+
+    // Write the binary of the linked _program for _key
+    static bool store(uint64_t _key, GLuint _program);
+
+};
+
+}
@@ -44,6 +44,7 @@ GLuint RenderState::getTextureUnit(GLuint _unit) {
 RenderState::~RenderState() {
 
     deleteQuadIndexBuffer();
+    deleteQuadCornerBuffer();
 
     for (auto& s : vertexShaders) {
         GL::deleteShader(s.second);
@@ -363,6 +364,25 @@ void RenderState::generateQuadIndexBuffer() {
 
 }
 
+GLuint RenderState::getQuadCornerBuffer() {
+    if (m_quadCornerBuffer == 0) {
+        const GLfloat corners[] = { -1.f, 1.f, 1.f, 1.f, -1.f, -1.f, 1.f, -1.f };
+
+        GL::genBuffers(1, &m_quadCornerBuffer);
+        vertexBuffer(m_quadCornerBuffer);
+        GL::bufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    }
+    return m_quadCornerBuffer;
+}
+
+void RenderState::deleteQuadCornerBuffer() {
+    if (m_quadCornerBuffer == 0) { return; }
+
+    vertexBufferUnset(m_quadCornerBuffer);
+    GL::deleteBuffers(1, &m_quadCornerBuffer);
+    m_quadCornerBuffer = 0;
+}
+
 bool RenderState::framebuffer(GLuint handle) {
     if (!m_framebuffer.set || m_framebuffer.handle != handle) {
         m_framebuffer = { handle, true };
@@ -108,6 +108,10 @@ public:
 
     GLuint getQuadIndexBuffer();
 
+    // Vertex buffer with the four corners of a quad in the order of the quad
+    // index buffer, as two floats per corner. Used for instanced quads.
+    GLuint getQuadCornerBuffer();
+
     std::array<GLuint, MAX_ATTRIBUTES> attributeBindings = { { 0 } };
 
     JobQueue jobQueue;
@@ -123,6 +127,9 @@ private:
     void deleteQuadIndexBuffer();
     void generateQuadIndexBuffer();
 
+    GLuint m_quadCornerBuffer = 0;
+    void deleteQuadCornerBuffer();
+
     struct {
         GLboolean enabled;
         bool set;
@@ -2,16 +2,30 @@
 
 #include "gl/disposer.h"
 #include "gl/glError.h"
+#include "gl/hardware.h"
+#include "gl/programCache.h"
 #include "gl/renderState.h"
 #include "glm/gtc/type_ptr.hpp"
 #include "scene/light.h"
 #include "log.h"
 #include "platform.h"
 
+#include <chrono>
 #include <sstream>
 
 namespace Tangram {
 
+thread_local ShaderProgram::BuildStats s_buildStats;
+
+static float elapsedMs(std::chrono::steady_clock::time_point _start) {
+    auto elapsed = std::chrono::steady_clock::now() - _start;
+    return std::chrono::duration<float, std::milli>(elapsed).count();
+}
+
+const ShaderProgram::BuildStats& ShaderProgram::buildStats() {
+    return s_buildStats;
+}
+
 ShaderProgram::ShaderProgram() {
     // Nothing to do.
 }
@@ -76,44 +90,68 @@ bool ShaderProgram::build(RenderState& rs) {
     GL::deleteProgram(m_glProgram);
     m_glProgram = 0;
 
-    auto& vertSrc = m_vertexShaderSource;
-    auto& fragSrc = m_fragmentShaderSource;
+    auto start = std::chrono::steady_clock::now();
 
-    // Compile vertex and fragment shaders
-    GLint vertexShader = makeCompiledShader(rs, vertSrc, GL_VERTEX_SHADER);
-    if (vertexShader == 0) {
-        LOGE("Shader compilation failed for %s", m_description.c_str());
-        return false;
-    }
+    GLuint program = 0;
+    uint64_t cacheKey = 0;
+    bool useCache = ProgramCache::enabled();
 
-    GLint fragmentShader = makeCompiledShader(rs, fragSrc, GL_FRAGMENT_SHADER);
-    if (fragmentShader == 0) {
-        LOGE("Shader compilation failed for %s", m_description.c_str());
-        return false;
+    if (useCache) {
+        cacheKey = ProgramCache::key(m_vertexShaderSource, m_fragmentShaderSource);
+        program = ProgramCache::load(cacheKey);
+        if (program != 0) {
+            s_buildStats.cached++;
+            s_buildStats.cacheTime += elapsedMs(start);
+        }
     }
 
-    // Link shaders into a program
-    GLint program = makeLinkedShaderProgram(fragmentShader, vertexShader);
     if (program == 0) {
-        LOGE("Shader compilation failed for %s", m_description.c_str());
-        return false;
+        program = makeCompiledProgram(rs, m_vertexShaderSource, m_fragmentShaderSource);
+        if (program == 0) {
+            LOGE("Shader compilation failed for %s", m_description.c_str());
+            return false;
+        }
+        s_buildStats.compiled++;
+        s_buildStats.compileTime += elapsedMs(start);
+
+        if (useCache) { ProgramCache::store(cacheKey, program); }
     }
 
     m_glProgram = program;
 
-    // Clear any cached shader locations
+    // Clear any cached shader locations and uniform values
     m_attribMap.clear();
+    m_uniformCache.clear();
     m_disposer = Disposer(rs);
 
+    m_generation++;
+
     return true;
 }
 
+GLuint ShaderProgram::makeCompiledProgram(RenderState& rs, const std::string& _vertSrc,
+                                          const std::string& _fragSrc) {
+
+    GLint vertexShader = makeCompiledShader(rs, _vertSrc, GL_VERTEX_SHADER);
+    if (vertexShader == 0) { return 0; }
+
+    GLint fragmentShader = makeCompiledShader(rs, _fragSrc, GL_FRAGMENT_SHADER);
+    if (fragmentShader == 0) { return 0; }
+
+    return makeLinkedShaderProgram(fragmentShader, vertexShader);
+}
+
 GLuint ShaderProgram::makeLinkedShaderProgram(GLint _fragShader, GLint _vertShader) {
 
     GLuint program = GL::createProgram();
 
     GL::attachShader(program, _fragShader);
     GL::attachShader(program, _vertShader);
+
+    if (Hardware::supportsProgramBinary) {
+        // Desktop drivers may return empty binaries without this hint
+        GL::programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     GL::linkProgram(program);
 
     GLint isLinked;
@@ -23,6 +23,17 @@ class ShaderProgram {
 
 public:
 
+    // Programs built by the calling thread since startup and the time spent
+    // on it, for FrameInfo
+    struct BuildStats {
+        uint32_t compiled = 0;
+        uint32_t cached = 0;
+        float compileTime = 0.f; // ms compiling and linking from source
+        float cacheTime = 0.f;   // ms loading binaries from the ProgramCache
+    };
+
+    static const BuildStats& buildStats();
+
     ShaderProgram();
     ~ShaderProgram();
 
@@ -52,6 +63,14 @@ public:
     // Return true if this object represents a valid OpenGL shader program.
     bool isValid() const { return m_glProgram != 0; };
 
+    // Incremented each time the program is (re)linked, uniforms must be set again then.
+    uint32_t generation() const { return m_generation; }
+
+    // The style that last set view, light and material uniforms of this program. Programs
+    // are shared by styles with identical sources, which must then set their values again.
+    const void* uniformOwner() const { return m_uniformOwner; }
+    void setUniformOwner(const void* _owner) { m_uniformOwner = _owner; }
+
     // Bind the program in OpenGL if it is not already bound; If the shader sources
     // have been modified since the last time build() was called, also calls build().
     // Returns true if shader can be used (i.e. is valid).
@@ -86,6 +105,8 @@ public:
     void setDescription(std::string _description) { m_description = _description; }
 
     static GLuint makeLinkedShaderProgram(GLint _fragShader, GLint _vertShader);
+    static GLuint makeCompiledProgram(RenderState& rs, const std::string& _vertSrc,
+                                      const std::string& _fragSrc);
     static GLuint makeCompiledShader(RenderState& rs, const std::string& _src, GLenum _type);
 
     const std::string& vertexShaderSource() { return m_vertexShaderSource; }
@@ -120,6 +141,10 @@ private:
 
     bool m_needsBuild = true;
 
+    uint32_t m_generation = 0;
+
+    const void* m_uniformOwner = nullptr;
+
     Disposer m_disposer;
 
 };
@@ -17,6 +17,7 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#include <algorithm>
 #include <cstring> // for memset
 
 namespace Tangram {
@@ -48,14 +49,20 @@ Texture::~Texture() {
 
         GL::deleteTextures(1, &glHandle);
     });
+
+    setGPUBytes(0);
 }
 
 bool Texture::loadImageFromMemory(const std::vector<char>& _data) {
+    return loadImageFromMemory(_data.data(), _data.size());
+}
+
+bool Texture::loadImageFromMemory(const char* _data, size_t _size) {
     unsigned char* pixels = nullptr;
     int width, height, comp;
 
-    if (_data.size() != 0) {
-        pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(_data.data()), _data.size(), &width, &height, &comp, STBI_rgb_alpha);
+    if (_size != 0) {
+        pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(_data), _size, &width, &height, &comp, STBI_rgb_alpha);
     }
 
     if (pixels) {
@@ -95,6 +102,7 @@ Texture& Texture::operator=(Texture&& _other) {
     m_options = _other.m_options;
     m_data = std::move(_other.m_data);
     m_dirtyRanges = std::move(_other.m_dirtyRanges);
+    m_dirtyRects = std::move(_other.m_dirtyRects);
     m_shouldResize = _other.m_shouldResize;
     m_width = _other.m_width;
     m_height = _other.m_height;
@@ -102,6 +110,12 @@ Texture& Texture::operator=(Texture&& _other) {
     m_generateMipmaps = _other.m_generateMipmaps;
     m_disposer = std::move(_other.m_disposer);
 
+    // Storage moves along with the handle
+    setGPUBytes(0);
+    m_memoryCategory = _other.m_memoryCategory;
+    m_gpuBytes = _other.m_gpuBytes;
+    _other.m_gpuBytes = 0;
+
     return *this;
 }
 
@@ -133,7 +147,7 @@ void Texture::setSubData(const GLuint* _subData, uint16_t _xoff, uint16_t _yoff,
         std::memcpy(&m_data[pos], &_subData[posIn], _width * bpp);
     }
 
-    setDirty(_yoff, _height);
+    setDirtyRect(_xoff, _yoff, _width, _height);
 }
 
 void Texture::setDirty(size_t _yoff, size_t _height) {
@@ -178,6 +192,41 @@ void Texture::setDirty(size_t _yoff, size_t _height) {
     }
 }
 
+void Texture::setDirtyRect(size_t _xoff, size_t _yoff, size_t _width, size_t _height) {
+
+    if (_width == 0 || _height == 0) { return; }
+
+    if (_xoff == 0 && _width >= m_width) {
+        setDirty(_yoff, _height);
+        return;
+    }
+
+    // Merge two regions when their bounding rectangle is not much larger
+    // than the regions themselves, e.g. neighboring glyphs on an atlas shelf.
+    const float maxMergeOverhead = 1.5f;
+
+    DirtyRect rect { _xoff, _yoff, _xoff + _width, _yoff + _height };
+
+    bool merged = true;
+    while (merged) {
+        merged = false;
+
+        for (auto it = m_dirtyRects.begin(); it != m_dirtyRects.end(); ++it) {
+            DirtyRect bounds { std::min(rect.x0, it->x0), std::min(rect.y0, it->y0),
+                               std::max(rect.x1, it->x1), std::max(rect.y1, it->y1) };
+
+            if (bounds.area() <= (rect.area() + it->area()) * maxMergeOverhead) {
+                rect = bounds;
+                m_dirtyRects.erase(it);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    m_dirtyRects.push_back(rect);
+}
+
 void Texture::bind(RenderState& rs, GLuint _unit) {
     rs.textureUnit(_unit);
     rs.texture(m_target, m_glHandle);
@@ -203,7 +252,7 @@ bool Texture::isValid() const {
 
 void Texture::update(RenderState& rs, GLuint _textureUnit) {
 
-    if (!m_shouldResize && m_dirtyRanges.empty()) {
+    if (!m_shouldResize && !isDirty()) {
         return;
     }
 
@@ -223,7 +272,7 @@ void Texture::update(RenderState& rs, GLuint _textureUnit) {
 
 void Texture::update(RenderState& rs, GLuint _textureUnit, const GLuint* data) {
 
-    if (!m_shouldResize && m_dirtyRanges.empty()) {
+    if (!m_shouldResize && !isDirty()) {
         return;
     }
 
@@ -247,9 +296,15 @@ void Texture::update(RenderState& rs, GLuint _textureUnit, const GLuint* data) {
         if (data && m_generateMipmaps) {
             // generate the mipmaps for this texture
             GL::generateMipmap(m_target);
+
+            // Mip levels add a third of the base level
+            setGPUBytes(bufferSize() * 4 / 3);
+        } else {
+            setGPUBytes(bufferSize());
         }
         m_shouldResize = false;
         m_dirtyRanges.clear();
+        m_dirtyRects.clear();
         return;
     }
     size_t bpp = bytesPerPixel();
@@ -261,7 +316,39 @@ void Texture::update(RenderState& rs, GLuint _textureUnit, const GLuint* data) {
                           m_options.format, GL_UNSIGNED_BYTE,
                           data + offset);
     }
+
+    auto* bytes = reinterpret_cast<const unsigned char*>(data);
+
+    for (auto& rect : m_dirtyRects) {
+        if (!bytes) { break; }
+
+        bool uploaded = std::any_of(m_dirtyRanges.begin(), m_dirtyRanges.end(), [&](auto& range) {
+                return rect.y0 >= range.min && rect.y1 <= range.max;
+            });
+        if (uploaded) { continue; }
+
+        // Copy the region into a contiguous buffer. Rows are padded to the
+        // default GL_UNPACK_ALIGNMENT of 4 bytes.
+        size_t rowBytes = (rect.x1 - rect.x0) * bpp;
+        size_t stride = (rowBytes + 3) & ~size_t(3);
+        size_t height = rect.y1 - rect.y0;
+
+        if (m_uploadBuffer.size() < stride * height) {
+            m_uploadBuffer.resize(stride * height);
+        }
+
+        for (size_t row = 0; row < height; row++) {
+            size_t offset = ((rect.y0 + row) * m_width + rect.x0) * bpp;
+            std::memcpy(&m_uploadBuffer[row * stride], bytes + offset, rowBytes);
+        }
+
+        GL::texSubImage2D(m_target, 0, rect.x0, rect.y0, rect.x1 - rect.x0, height,
+                          m_options.format, GL_UNSIGNED_BYTE,
+                          m_uploadBuffer.data());
+    }
+
     m_dirtyRanges.clear();
+    m_dirtyRects.clear();
 }
 
 void Texture::resize(const unsigned int _width, const unsigned int _height) {
@@ -279,12 +366,41 @@ void Texture::resize(const unsigned int _width, const unsigned int _height) {
 
     m_shouldResize = true;
     m_dirtyRanges.clear();
+    m_dirtyRects.clear();
 }
 
 bool Texture::isRepeatWrapping(TextureWrapping _wrapping) {
     return _wrapping.wraps == GL_REPEAT || _wrapping.wrapt == GL_REPEAT;
 }
 
+void Texture::setMemoryCategory(GPUMemory::Category _category) {
+    GPUMemory::update(m_memoryCategory, m_gpuBytes, 0);
+    GPUMemory::update(_category, 0, m_gpuBytes);
+    m_memoryCategory = _category;
+}
+
+void Texture::setGPUBytes(size_t _bytes) {
+    GPUMemory::update(m_memoryCategory, m_gpuBytes, _bytes);
+    m_gpuBytes = _bytes;
+}
+
+void Texture::releaseGPUMemory() {
+
+    if (m_glHandle == 0) { return; }
+
+    auto glHandle = m_glHandle;
+    auto target = m_target;
+
+    m_disposer([=](RenderState& rs) {
+        rs.textureUnset(target, glHandle);
+        GL::deleteTextures(1, &glHandle);
+    });
+
+    m_glHandle = 0;
+    m_shouldResize = true;
+    setGPUBytes(0);
+}
+
 size_t Texture::bufferSize() {
     return m_width * m_height * bytesPerPixel();
 }
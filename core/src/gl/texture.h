@@ -2,6 +2,7 @@
 
 #include "gl.h"
 #include "gl/disposer.h"
+#include "gl/gpuMemory.h"
 #include "scene/spriteAtlas.h"
 
 #include <vector>
@@ -67,6 +68,11 @@ public:
 
     void setDirty(size_t yOffset, size_t height);
 
+    /* Mark a rectangular region for upload. Nearby regions are coalesced
+     * into larger rectangles to reduce the number of texSubImage2D calls.
+     */
+    void setDirtyRect(size_t _xoff, size_t _yoff, size_t _width, size_t _height);
+
     GLuint getGlHandle() { return m_glHandle; }
 
     /* Sets texture data
@@ -89,6 +95,7 @@ public:
     static bool isRepeatWrapping(TextureWrapping _wrapping);
 
     bool loadImageFromMemory(const std::vector<char>& _data);
+    bool loadImageFromMemory(const char* _data, size_t _size);
 
     static void flipImageData(unsigned char *result, int w, int h, int depth);
     static void flipImageData(GLuint *result, int w, int h);
@@ -98,6 +105,14 @@ public:
 
     auto& spriteAtlas() { return m_spriteAtlas; }
 
+    /* Category under which the texture storage is reported to GPUMemory */
+    void setMemoryCategory(GPUMemory::Category _category);
+
+    /* Delete the GL texture; it is created again from the texture data on the
+     * next update(), so this only applies to textures that keep their data.
+     */
+    void releaseGPUMemory();
+
 protected:
 
     void generate(RenderState& rs, GLuint _textureUnit);
@@ -112,6 +127,18 @@ protected:
     };
     std::vector<DirtyRange> m_dirtyRanges;
 
+    struct DirtyRect {
+        size_t x0, y0;
+        size_t x1, y1;
+        size_t area() const { return (x1 - x0) * (y1 - y0); }
+    };
+    std::vector<DirtyRect> m_dirtyRects;
+
+    // Scratch buffer for uploading regions narrower than the texture
+    std::vector<unsigned char> m_uploadBuffer;
+
+    bool isDirty() const { return !m_dirtyRanges.empty() || !m_dirtyRects.empty(); }
+
     bool m_shouldResize;
 
     unsigned int m_width;
@@ -121,6 +148,11 @@ protected:
 
     Disposer m_disposer;
 
+    GPUMemory::Category m_memoryCategory = GPUMemory::textures;
+    size_t m_gpuBytes = 0;
+
+    void setGPUBytes(size_t _bytes);
+
 private:
 
     bool m_generateMipmaps;
@@ -17,27 +17,58 @@ VertexLayout::VertexLayout(std::vector<VertexAttrib> _attribs) : m_attribs(_attr
         // as a void* to use with glVertexAttribPointer; We use reinterpret_cast to avoid warnings
         attrib.offset = m_stride;
 
-        GLint byteSize = attrib.size;
-
-        switch (attrib.type) {
-            case GL_FLOAT:
-            case GL_INT:
-            case GL_UNSIGNED_INT:
-                byteSize *= 4; // 4 bytes for floats, ints, and uints
-                break;
-            case GL_SHORT:
-            case GL_UNSIGNED_SHORT:
-                byteSize *= 2; // 2 bytes for shorts and ushorts
-                break;
-        }
-
-        m_stride += byteSize;
+        m_stride += getAttribSize(attrib);
 
         // TODO: Automatically add padding or warn if attributes are not byte-aligned
 
     }
 }
 
+GLint VertexLayout::getAttribSize(const VertexAttrib& _attrib) {
+
+    GLint byteSize = _attrib.size;
+
+    switch (_attrib.type) {
+        case GL_FLOAT:
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+            byteSize *= 4; // 4 bytes for floats, ints, and uints
+            break;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+            byteSize *= 2; // 2 bytes for shorts and ushorts
+            break;
+    }
+
+    return byteSize;
+}
+
+bool VertexLayout::hasAttrib(const std::string& _attribName) const {
+
+    for (auto& attrib : m_attribs) {
+        if (attrib.name == _attribName) { return true; }
+    }
+    return false;
+}
+
+std::shared_ptr<VertexLayout> VertexLayout::without(const std::string& _attribName) {
+
+    // Builders call this from the worker threads
+    std::lock_guard<std::mutex> lock(m_reducedMutex);
+
+    auto& layout = m_reduced[_attribName];
+
+    if (!layout) {
+        std::vector<VertexAttrib> attribs;
+        for (auto& attrib : m_attribs) {
+            if (attrib.name != _attribName) { attribs.push_back(attrib); }
+        }
+        layout = std::make_shared<VertexLayout>(attribs);
+    }
+
+    return layout;
+}
+
 size_t VertexLayout::getOffset(std::string _attribName) {
 
     for (auto& attrib : m_attribs) {
@@ -104,4 +135,29 @@ void VertexLayout::enable(RenderState& rs, ShaderProgram& _program, size_t _byte
     }
 }
 
+void VertexLayout::setDivisor(ShaderProgram& _program, GLuint _divisor) {
+
+    for (auto& attrib : m_attribs) {
+        GLint location = _program.getAttribLocation(attrib.name);
+
+        if (location != -1) {
+            GL::vertexAttribDivisor(location, _divisor);
+        }
+    }
+}
+
+void VertexLayout::disable(RenderState& rs, ShaderProgram& _program) {
+
+    GLuint glProgram = _program.getGlProgram();
+
+    for (auto& attrib : m_attribs) {
+        GLint location = _program.getAttribLocation(attrib.name);
+
+        if (location != -1 && rs.attributeBindings[location] == glProgram) {
+            GL::disableVertexAttribArray(location);
+            rs.attributeBindings[location] = 0;
+        }
+    }
+}
+
 }
@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace Tangram {
@@ -31,17 +32,37 @@ public:
 
     void enable(const fastmap<std::string, GLuint>& _locations, size_t _bytOffset);
 
+    // Advance the attributes of this layout once per _divisor instances
+    // instead of once per vertex; requires Hardware::supportsInstancedArrays
+    void setDivisor(ShaderProgram& _program, GLuint _divisor);
+
+    // Disable the attributes of this layout that are enabled for _program
+    void disable(RenderState& rs, ShaderProgram& _program);
+
     GLint getStride() const { return m_stride; };
 
     const std::vector<VertexAttrib> getAttribs() const { return m_attribs; }
 
     size_t getOffset(std::string _attribName);
 
+    bool hasAttrib(const std::string& _attribName) const;
+
+    static GLint getAttribSize(const VertexAttrib& _attrib);
+
+    /* Returns this layout without the attribute _attribName. The reduced
+     * layout is created once, so that all meshes that drop the attribute
+     * share it.
+     */
+    std::shared_ptr<VertexLayout> without(const std::string& _attribName);
+
 private:
 
     std::vector<VertexAttrib> m_attribs;
     GLint m_stride;
 
+    std::mutex m_reducedMutex;
+    fastmap<std::string, std::shared_ptr<VertexLayout>> m_reduced;
+
 };
 
 }
@@ -7,6 +7,7 @@
 #include "style/textStyle.h"
 #include "text/fontContext.h"
 #include "textLabels.h"
+#include "util/batchProjection.h"
 #include "util/geom.h"
 #include "util/lineSampler.h"
 #include "view/view.h"
@@ -36,22 +37,31 @@ void CurvedLabel::applyAnchor(LabelProperty::Anchor _anchor) {
     m_anchor = LabelProperty::anchorDirection(_anchor) * offset * 0.5f;
 }
 
-bool CurvedLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
+void CurvedLabel::addProjectionPoints(const ViewState& _viewState, BatchProjection& _projection) {
+
+    m_projectionIndex = _projection.size();
+
+    for (auto& p : m_modelTransform) {
+        _projection.add(p);
+    }
+}
+
+bool CurvedLabel::updateScreenTransform(const BatchProjection& _projection, const ViewState& _viewState,
                                         const AABB* _bounds, ScreenTransform& _transform) {
 
     glm::vec2 min(-m_dim.y);
     glm::vec2 max(_viewState.viewportSize + m_dim.y);
 
-    bool clipped = false;
     bool inside = false;
 
     LineSampler<ScreenTransform> sampler { _transform };
 
-    for (auto& p : m_modelTransform) {
-        glm::vec2 sp = worldToScreenSpace(_mvp, glm::vec4(p, 0.0, 1.0),
-                                          _viewState.viewportSize, clipped);
+    for (size_t i = 0; i < m_modelTransform.size(); i++) {
+        size_t index = m_projectionIndex + i;
+
+        if (_projection.clipped(index)) { return false; }
 
-        if (clipped) { return false; }
+        glm::vec2 sp = _projection.screenPosition(index);
 
         sampler.add(sp);
 
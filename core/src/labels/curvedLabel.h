@@ -38,7 +38,9 @@ public:
         applyAnchor(m_options.anchors[0]);
     }
 
-    bool updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
+    void addProjectionPoints(const ViewState& _viewState, BatchProjection& _projection) override;
+
+    bool updateScreenTransform(const BatchProjection& _projection, const ViewState& _viewState,
                                const AABB* _bounds, ScreenTransform& _transform) override;
 
     void obbs(ScreenTransform& _transform, OBBBuffer& _obbs) override;
@@ -31,6 +31,7 @@ Label::Label(glm::vec2 _size, Type _type, Options _options)
     m_occluded = false;
     m_relative = nullptr;
     m_anchorIndex = 0;
+    m_projectionIndex = 0;
 }
 
 Label::~Label() {}
@@ -125,13 +126,13 @@ bool Label::setAnchorIndex(int _index) {
     return true;
 }
 
-bool Label::update(const glm::mat4& _mvp, const ViewState& _viewState,
+bool Label::update(const BatchProjection& _projection, const ViewState& _viewState,
                    const AABB* _bounds, ScreenTransform& _transform) {
 
     m_occludedLastFrame = m_occluded;
     m_occluded = false;
 
-    bool valid = updateScreenTransform(_mvp, _viewState, _bounds, _transform);
+    bool valid = updateScreenTransform(_projection, _viewState, _bounds, _transform);
     if (!valid) {
         enterState(State::sleep, 0.0);
         return false;
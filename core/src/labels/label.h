@@ -18,6 +18,7 @@
 
 namespace Tangram {
 
+class BatchProjection;
 struct ScreenTransform;
 struct ViewState;
 struct OBBBuffer;
@@ -91,13 +92,17 @@ public:
 
     virtual const Texture* texture() const { return nullptr; }
 
-    bool update(const glm::mat4& _mvp, const ViewState& _viewState,
+    bool update(const BatchProjection& _projection, const ViewState& _viewState,
                 const AABB* _bounds, ScreenTransform& _transform);
 
     bool evalState(float _dt);
 
-    // Update the screen position of the label
-    virtual bool updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
+    // Add the model space points of this label to the projection batch of its tile.
+    // The batch is projected once before updateScreenTransform is called.
+    virtual void addProjectionPoints(const ViewState& _viewState, BatchProjection& _projection) = 0;
+
+    // Update the screen position of the label from its projected points
+    virtual bool updateScreenTransform(const BatchProjection& _projection, const ViewState& _viewState,
                                        const AABB* _bounds, ScreenTransform& _transform) = 0;
 
     // Current screen position of the label anchor
@@ -178,6 +183,9 @@ protected:
 
     glm::vec2 m_screenCenter;
     float m_alpha;
+
+    // Index of the first point added by addProjectionPoints
+    size_t m_projectionIndex;
 };
 
 }
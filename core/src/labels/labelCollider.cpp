@@ -109,11 +109,17 @@ void LabelCollider::process(TileID _tileID, float _tileInverseScale, float _tile
     m_obbs.clear();
     m_transforms.clear();
 
+    m_projection.clear();
+    for (auto& entry : m_labels) {
+        entry.label->addProjectionPoints(viewState, m_projection);
+    }
+    m_projection.project(mvp, screenSize);
+
     for (auto it = m_labels.begin(); it != m_labels.end(); ) {
         auto& entry = *it;
         auto* label = entry.label;
         ScreenTransform transform { m_transforms, entry.transform };
-        if (label->updateScreenTransform(mvp, viewState, nullptr, transform)) {
+        if (label->updateScreenTransform(m_projection, viewState, nullptr, transform)) {
 
             OBBBuffer obbs { m_obbs, entry.obbs };
 
@@ -2,6 +2,7 @@
 
 #include "labels/label.h"
 #include "labels/screenTransform.h"
+#include "util/batchProjection.h"
 #include "util/mapProjection.h"
 #include "util/types.h"
 
@@ -55,6 +56,7 @@ private:
     isect2d::ISect2D<glm::vec2> m_isect2d;
 
     ScreenTransform::Buffer m_transforms;
+    BatchProjection m_projection;
 };
 
 }
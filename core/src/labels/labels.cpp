@@ -25,6 +25,7 @@
 #include "glm/gtx/norm.hpp"
 
 #include <cassert>
+#include <chrono>
 
 namespace Tangram {
 
@@ -48,6 +49,16 @@ void Labels::processLabelUpdate(const ViewState& _viewState, const LabelSet* _la
                       _viewState.viewportSize.x,
                       _viewState.viewportSize.y);
 
+    // Project the points of all labels in the set at once
+    m_projection.clear();
+    for (auto& label : _labelSet->getLabels()) {
+        if (!_drawAll && (label->state() == Label::State::dead) ) {
+            continue;
+        }
+        label->addProjectionPoints(_viewState, m_projection);
+    }
+    m_projection.project(_mvp, _viewState.viewportSize);
+
     for (auto& label : _labelSet->getLabels()) {
         if (!_drawAll && (label->state() == Label::State::dead) ) {
             continue;
@@ -61,7 +72,7 @@ void Labels::processLabelUpdate(const ViewState& _viewState, const LabelSet* _la
             ? screenBounds
             : extendedBounds;
 
-        if (!label->update(_mvp, _viewState, &bounds, transform)) {
+        if (!label->update(m_projection, _viewState, &bounds, transform)) {
             continue;
         }
 
@@ -156,7 +167,8 @@ void Labels::updateLabels(const ViewState& _viewState, float _dt,
     }
 }
 
-void Labels::skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy) const {
+void Labels::skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy,
+                             SpatialHash<Label*>& _proxyLabels) const {
 
     for (const auto& style : _styles) {
 
@@ -166,24 +178,36 @@ void Labels::skipTransitions(const std::vector<const Style*>& _styles, Tile& _ti
         auto* mesh1 = dynamic_cast<const LabelSet*>(_proxy.getMesh(*style).get());
         if (!mesh1) { continue; }
 
+        _proxyLabels.clear();
+
         for (auto& l0 : mesh0->getLabels()) {
             if (!l0->canOcclude()) { continue; }
             if (l0->state() != Label::State::none) { continue; }
 
-            for (auto& l1 : mesh1->getLabels()) {
-                if (!l1->visibleState()) { continue; }
-                if (!l1->canOcclude()) { continue;}
+            _proxyLabels.addQueryRadius(l0->options().repeatGroup,
+                                        std::max(l0->dimension().x, l0->dimension().y));
+        }
+
+        for (auto& l1 : mesh1->getLabels()) {
+            if (!l1->visibleState()) { continue; }
+            if (!l1->canOcclude()) { continue;}
 
-                // Using repeat group to also handle labels with dynamic style properties
-                if (l0->options().repeatGroup != l1->options().repeatGroup) { continue; }
-                // if (l0->hash() != l1->hash()) { continue; }
+            // Using repeat group to also handle labels with dynamic style properties
+            _proxyLabels.insert(l1->options().repeatGroup, l1->screenCenter(), l1.get());
+        }
 
-                float d2 = glm::distance2(l0->screenCenter(), l1->screenCenter());
+        if (_proxyLabels.empty()) { continue; }
 
-                // The new label lies within the circle defined by the bbox of l0
-                if (sqrt(d2) < std::max(l0->dimension().x, l0->dimension().y)) {
-                    l0->skipTransitions();
-                }
+        for (auto& l0 : mesh0->getLabels()) {
+            if (!l0->canOcclude()) { continue; }
+            if (l0->state() != Label::State::none) { continue; }
+
+            // The new label lies within the circle defined by the bbox of l0
+            float radius = std::max(l0->dimension().x, l0->dimension().y);
+
+            if (_proxyLabels.query(l0->options().repeatGroup, l0->screenCenter(), radius,
+                                   [](Label*) { return true; })) {
+                l0->skipTransitions();
             }
         }
     }
@@ -209,6 +233,7 @@ void Labels::skipTransitions(const std::shared_ptr<Scene>& _scene,
                              TileManager& _tileManager, float _currentZoom) const {
 
     std::vector<const Style*> styles;
+    SpatialHash<Label*> proxyLabels;
 
     for (const auto& style : _scene->styles()) {
         if (dynamic_cast<const TextStyle*>(style.get()) ||
@@ -233,13 +258,13 @@ void Labels::skipTransitions(const std::shared_ptr<Scene>& _scene,
             // zooming in, add the one cached parent tile
             proxy = findProxy(tile->sourceID(), tileID.getParent(source->zoomBias()), _tiles,
                               *_tileManager.getTileCache());
-            if (proxy) { skipTransitions(styles, *tile, *proxy); }
+            if (proxy) { skipTransitions(styles, *tile, *proxy, proxyLabels); }
         } else {
             // zooming out, add the 4 cached children tiles
             for (int i = 0; i < 4; i++) {
                 proxy = findProxy(tile->sourceID(), tileID.getChild(i, source->maxZoom()), _tiles,
                                   *_tileManager.getTileCache());
-                if (proxy) { skipTransitions(styles, *tile, *proxy); }
+                if (proxy) { skipTransitions(styles, *tile, *proxy, proxyLabels); }
             }
         }
     }
@@ -324,6 +349,13 @@ void Labels::handleOcclusions(const ViewState& _viewState) {
     m_isect2d.clear();
     m_repeatGroups.clear();
 
+    for (auto& entry : m_labels) {
+        auto& options = entry.label->options();
+        if (options.repeatDistance > 0.f) {
+            m_repeatGroups.addQueryRadius(options.repeatGroup, options.repeatDistance);
+        }
+    }
+
     using iterator = decltype(m_labels)::const_iterator;
 
     // Find the label to which the obb belongs
@@ -423,25 +455,17 @@ void Labels::handleOcclusions(const ViewState& _viewState) {
             }
 
             if (l->options().repeatDistance > 0.f) {
-                m_repeatGroups[l->options().repeatGroup].push_back(l);
+                m_repeatGroups.insert(l->options().repeatGroup, l->screenCenter(), l);
             }
         }
     }
 }
 
 bool Labels::withinRepeatDistance(Label *_label) {
-    float threshold2 = pow(_label->options().repeatDistance, 2);
-
-    auto it = m_repeatGroups.find(_label->options().repeatGroup);
-    if (it != m_repeatGroups.end()) {
-        for (auto* ll : it->second) {
-            float d2 = glm::distance2(_label->screenCenter(), ll->screenCenter());
-            if (d2 < threshold2) {
-                return true;
-            }
-        }
-    }
-    return false;
+
+    return m_repeatGroups.query(_label->options().repeatGroup, _label->screenCenter(),
+                                _label->options().repeatDistance,
+                                [](Label*) { return true; });
 }
 
 void Labels::updateLabelSet(const ViewState& _viewState, float _dt,
@@ -468,8 +492,13 @@ void Labels::updateLabelSet(const ViewState& _viewState, float _dt,
     m_isect2d.resize({_viewState.viewportSize.x / 256, _viewState.viewportSize.y / 256},
                      {_viewState.viewportSize.x, _viewState.viewportSize.y});
 
+    auto start = std::chrono::steady_clock::now();
+
     handleOcclusions(_viewState);
 
+    m_collisionTime.record(std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - start).count());
+
     // Update label state
     for (auto& entry : m_labels) {
         m_needUpdate |= entry.label->evalState(_dt);
@@ -479,11 +508,15 @@ void Labels::updateLabelSet(const ViewState& _viewState, float _dt,
 
     Label::AABB screenBounds{0, 0, _viewState.viewportSize.x, _viewState.viewportSize.y};
 
+    m_visibleLabels = 0;
+
     // Update label meshes
     for (auto& entry : m_labels) {
 
         if (!entry.label->visibleState()) { continue; }
 
+        m_visibleLabels++;
+
         ScreenTransform transform { m_transforms, entry.transformRange };
 
         for (auto& obb : OBBBuffer{ m_obbs, entry.obbsRange }) {
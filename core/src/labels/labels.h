@@ -3,8 +3,11 @@
 #include "data/properties.h"
 #include "labels/label.h"
 #include "labels/screenTransform.h"
+#include "labels/spatialHash.h"
 #include "labels/spriteLabel.h"
 #include "tile/tileID.h"
+#include "util/batchProjection.h"
+#include "util/histogram.h"
 
 #include "glm_vec.h" // for isect2d.h
 #include "isect2d.h"
@@ -54,6 +57,13 @@ public:
 
     std::pair<Label*, const Tile*> getLabel(uint32_t _selectionColor) const;
 
+    /* Labels considered and shown by the last updateLabelSet() */
+    size_t labelCount() const { return m_labels.size(); }
+    size_t visibleLabelCount() const { return m_visibleLabels; }
+
+    /* Time in ms spent on resolving label collisions in updateLabelSet() */
+    Histogram& collisionTime() { return m_collisionTime; }
+
 protected:
 
     using AABB = isect2d::AABB<glm::vec2>;
@@ -65,7 +75,8 @@ protected:
                          const std::vector<std::shared_ptr<Tile>>& _tiles,
                          TileManager& _tileManager, float _currentZoom) const;
 
-    void skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy) const;
+    void skipTransitions(const std::vector<const Style*>& _styles, Tile& _tile, Tile& _proxy,
+                         SpatialHash<Label*>& _proxyLabels) const;
 
     void handleOcclusions(const ViewState& _viewState);
 
@@ -108,13 +119,18 @@ protected:
 
     std::vector<OBB> m_obbs;
     ScreenTransform::Buffer m_transforms;
+    BatchProjection m_projection;
 
     std::vector<LabelEntry> m_labels;
     std::vector<LabelEntry> m_selectionLabels;
 
-    std::unordered_map<size_t, std::vector<Label*>> m_repeatGroups;
+    // Visible labels with repeat distance by repeat group and screen position
+    SpatialHash<Label*> m_repeatGroups;
 
     float m_lastZoom;
+
+    size_t m_visibleLabels = 0;
+    Histogram m_collisionTime;
 };
 
 }
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "util/hash.h"
+
+#include "glm/vec2.hpp"
+#include "glm/gtx/norm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* SpatialHash buckets items by group and screen space grid cell, so that
+ * finding items of one group near a position only looks at the few cells
+ * around it instead of all items of the group.
+ * Each group has its own cell size, which covers the largest query radius
+ * announced with addQueryRadius() before the items of the group are inserted.
+ */
+template<typename T>
+class SpatialHash {
+
+public:
+
+    // Remove all items and query radii. The cells keep their storage for the
+    // next use; cells that stayed empty since the previous clear() are freed.
+    void clear() {
+        for (auto it = m_cells.begin(); it != m_cells.end();) {
+            if (it->second.empty()) {
+                it = m_cells.erase(it);
+            } else {
+                it->second.clear();
+                ++it;
+            }
+        }
+        m_cellSizes.clear();
+        m_count = 0;
+    }
+
+    bool empty() const { return m_count == 0; }
+
+    // Grow the cell size of _group so that queries with _radius visit at
+    // most 3x3 cells. Must be called before items are inserted into _group.
+    void addQueryRadius(size_t _group, float _radius) {
+        auto& cellSize = m_cellSizes.emplace(_group, min_cell_size).first->second;
+        cellSize = std::max(cellSize, _radius);
+    }
+
+    // Insert _item at _position
+    void insert(size_t _group, glm::vec2 _position, T _item) {
+        float cellSize = m_cellSizes.emplace(_group, min_cell_size).first->second;
+
+        m_cells[key(_group, cell(_position, cellSize))].push_back({ _position, _item });
+        m_count++;
+    }
+
+    // Call _fn for each item of _group closer than _radius to _position,
+    // until _fn returns true. Returns true if _fn returned true.
+    template<typename F>
+    bool query(size_t _group, glm::vec2 _position, float _radius, F&& _fn) const {
+        auto it = m_cellSizes.find(_group);
+        if (it == m_cellSizes.end()) { return false; }
+
+        float cellSize = it->second;
+        float radius2 = _radius * _radius;
+
+        glm::ivec2 min = cell(_position - _radius, cellSize);
+        glm::ivec2 max = cell(_position + _radius, cellSize);
+
+        for (int y = min.y; y <= max.y; y++) {
+            for (int x = min.x; x <= max.x; x++) {
+                auto entries = m_cells.find(key(_group, {x, y}));
+                if (entries == m_cells.end()) { continue; }
+
+                for (auto& entry : entries->second) {
+                    if (glm::distance2(entry.position, _position) < radius2 && _fn(entry.item)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+
+    // Lower bound for the cell size to limit the number of cells visited by query
+    static constexpr float min_cell_size = 16.f;
+
+    struct Key {
+        size_t group;
+        glm::ivec2 cell;
+
+        bool operator==(const Key& _other) const {
+            return group == _other.group && cell == _other.cell;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& _key) const {
+            size_t seed = _key.group;
+            hash_combine(seed, _key.cell.x);
+            hash_combine(seed, _key.cell.y);
+            return seed;
+        }
+    };
+
+    struct Entry {
+        glm::vec2 position;
+        T item;
+    };
+
+    static Key key(size_t _group, glm::ivec2 _cell) { return { _group, _cell }; }
+
+    static glm::ivec2 cell(glm::vec2 _position, float _cellSize) {
+        return { int(std::floor(_position.x / _cellSize)),
+                 int(std::floor(_position.y / _cellSize)) };
+    }
+
+    std::unordered_map<Key, std::vector<Entry>, KeyHash> m_cells;
+    std::unordered_map<size_t, float> m_cellSizes;
+    size_t m_count = 0;
+};
+
+template<typename T>
+constexpr float SpatialHash<T>::min_cell_size;
+
+}
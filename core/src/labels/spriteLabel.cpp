@@ -6,6 +6,7 @@
 #include "log.h"
 #include "scene/spriteAtlas.h"
 #include "style/pointStyle.h"
+#include "util/batchProjection.h"
 #include "util/geom.h"
 #include "view/view.h"
 
@@ -73,57 +74,67 @@ void SpriteLabel::applyAnchor(LabelProperty::Anchor _anchor) {
     m_anchor = LabelProperty::anchorDirection(_anchor) * m_dim * 0.5f;
 }
 
-bool SpriteLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
-                                        const AABB* _bounds, ScreenTransform& _transform) {
+void SpriteLabel::addProjectionPoints(const ViewState& _viewState, BatchProjection& _projection) {
 
-    glm::vec2 halfScreen = glm::vec2(_viewState.viewportSize * 0.5f);
     glm::vec2 p0 = m_coordinates;
 
-    if (m_options.flat) {
+    m_projectionIndex = _projection.add(p0);
 
-        std::array<glm::vec2, 4> positions;
-        std::array<glm::vec3, 4> projected;
+    if (!m_options.flat) { return; }
 
-        float sourceScale = pow(2, m_coordinates.z);
+    std::array<glm::vec2, 4> positions;
 
-        float scale = float(sourceScale / (_viewState.zoomScale * _viewState.tileSize));
-        float zoomFactor = m_vertexAttrib.extrudeScale * _viewState.fractZoom;
+    float sourceScale = pow(2, m_coordinates.z);
 
-        glm::vec2 dim = (m_dim + zoomFactor) * scale;
+    float scale = float(sourceScale / (_viewState.zoomScale * _viewState.tileSize));
+    float zoomFactor = m_vertexAttrib.extrudeScale * _viewState.fractZoom;
 
-        // Center around 0,0
-        dim *= 0.5f;
+    glm::vec2 dim = (m_dim + zoomFactor) * scale;
 
-        positions[0] = -dim;
-        positions[1] = glm::vec2(dim.x, -dim.y);
-        positions[2] = glm::vec2(-dim.x, dim.y);
-        positions[3] = dim;
+    // Center around 0,0
+    dim *= 0.5f;
 
-        // Rotate in clockwise order on the ground plane
-        if (m_options.angle != 0.f) {
-            glm::vec2 rotation(cos(DEG_TO_RAD * m_options.angle),
-                               sin(DEG_TO_RAD * m_options.angle));
+    positions[0] = -dim;
+    positions[1] = glm::vec2(dim.x, -dim.y);
+    positions[2] = glm::vec2(-dim.x, dim.y);
+    positions[3] = dim;
 
-            for (size_t i = 0; i < 4; i++) {
-                positions[i] = rotateBy(positions[i], rotation);
-            }
-        }
+    // Rotate in clockwise order on the ground plane
+    if (m_options.angle != 0.f) {
+        glm::vec2 rotation(cos(DEG_TO_RAD * m_options.angle),
+                           sin(DEG_TO_RAD * m_options.angle));
 
-        AABB aabb;
         for (size_t i = 0; i < 4; i++) {
+            positions[i] = rotateBy(positions[i], rotation);
+        }
+    }
+
+    for (size_t i = 0; i < 4; i++) {
+        _projection.add(positions[i] + p0);
+    }
+}
+
+bool SpriteLabel::updateScreenTransform(const BatchProjection& _projection, const ViewState& _viewState,
+                                        const AABB* _bounds, ScreenTransform& _transform) {
+
+    if (_projection.clipped(m_projectionIndex)) { return false; }
+
+    glm::vec3 projected = _projection.ndc(m_projectionIndex);
+    glm::vec2 position = _projection.screenPosition(m_projectionIndex) + m_options.offset;
+
+    if (m_options.flat) {
 
-            positions[i] += p0;
+        std::array<glm::vec2, 4> positions;
+        std::array<glm::vec3, 4> projectedCorners;
 
-            glm::vec4 proj = worldToClipSpace(_mvp, glm::vec4(positions[i], 0.f, 1.f));
-            if (proj.w <= 0.0f) { return false; }
+        AABB aabb;
+        for (size_t i = 0; i < 4; i++) {
+            size_t index = m_projectionIndex + 1 + i;
 
-            projected[i] = glm::vec3(proj) / proj.w;
+            if (_projection.clipped(index)) { return false; }
 
-            // from normalized device coordinates to screen space coordinate system
-            // top-left screen axis, y pointing down
-            positions[i].x = 1 + projected[i].x;
-            positions[i].y = 1 - projected[i].y;
-            positions[i] *= halfScreen;
+            positions[i] = _projection.screenPosition(index);
+            projectedCorners[i] = _projection.ndc(index);
 
             aabb.include(positions[i].x, positions[i].y);
         }
@@ -132,34 +143,12 @@ bool SpriteLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState&
             if (!aabb.intersect(*_bounds)) { return false; }
         }
 
-        FlatTransform(_transform).set(positions, projected);
-
-        {
-            glm::vec4 projected = worldToClipSpace(_mvp, glm::vec4(p0, 0.f, 1.f));
-            if (projected.w <= 0.0f) { return false; }
+        FlatTransform(_transform).set(positions, projectedCorners);
 
-            projected /= projected.w;
+        m_screenCenter = position;
 
-            glm::vec2 position;
-            position.x = 1 + projected.x;
-            position.y = 1 - projected.y;
-            position *= halfScreen;
-            position += m_options.offset;
-            m_screenCenter = position;
-        }
     } else {
 
-        glm::vec4 projected = worldToClipSpace(_mvp, glm::vec4(p0, 0.f, 1.f));
-        if (projected.w <= 0.0f) { return false; }
-
-        projected /= projected.w;
-
-        glm::vec2 position;
-        position.x = 1 + projected.x;
-        position.y = 1 - projected.y;
-        position *= halfScreen;
-        position += m_options.offset;
-
         if (_bounds) {
             auto aabb = m_options.anchors.extents(m_dim);
             aabb.min += position;
@@ -169,7 +158,7 @@ bool SpriteLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState&
 
         m_screenCenter = position;
 
-        BillboardTransform(_transform).set(position, glm::vec3(projected),
+        BillboardTransform(_transform).set(position, projected,
                                            _viewState.viewportSize, _viewState.fractZoom);
     }
 
@@ -234,6 +223,27 @@ void SpriteLabel::addVerticesToMesh(ScreenTransform& _transform, const glm::vec2
         uint16_t(m_alpha * SpriteVertex::alpha_scale),
     };
 
+    if (!m_options.flat) {
+        if (auto* instance = m_labels.m_style.pushInstance(m_texture)) {
+            BillboardTransform transform(_transform);
+
+            glm::vec2 scale = 2.0f / transform.screenSize();
+            scale.y *= -1;
+
+            instance->pos = glm::vec2(transform.projected()) +
+                (m_options.offset + m_anchor) * scale;
+
+            // Corners 1 and 3 are (1, 1) and (1, -1) of the rotated quad
+            glm::vec2 axisX = (quad.quad[1].pos + quad.quad[3].pos) * 0.5f * scale;
+            glm::vec2 axisY = (quad.quad[1].pos - quad.quad[3].pos) * 0.5f * scale;
+            instance->axes = glm::vec4(axisX, axisY);
+
+            instance->uvRect = glm::i16vec4(quad.quad[2].uv, quad.quad[1].uv);
+            instance->state = state;
+            return;
+        }
+    }
+
     auto* quadVertices = m_labels.m_style.pushQuad(m_texture);
 
     if (m_options.flat) {
@@ -26,6 +26,19 @@ struct SpriteVertex {
     static const float texture_scale;
 };
 
+// Instance record for billboard sprites when instanced arrays are available,
+// a quarter of the size of the four SpriteVertex of a quad
+struct SpriteInstance {
+    // Center of the sprite in clip space
+    glm::vec2 pos;
+    // Half axes of the rotated quad in clip space, the corner (x, y) is at
+    // pos + x * axes.xy + y * axes.zw
+    glm::vec4 axes;
+    // Texture coordinates of the bottom-left and top-right corners
+    glm::i16vec4 uvRect;
+    SpriteVertex::State state;
+};
+
 class SpriteLabel : public Label {
 public:
 
@@ -45,7 +58,9 @@ public:
 
     LabelType renderType() const override { return LabelType::icon; }
 
-    bool updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
+    void addProjectionPoints(const ViewState& _viewState, BatchProjection& _projection) override;
+
+    bool updateScreenTransform(const BatchProjection& _projection, const ViewState& _viewState,
                                const AABB* _bounds, ScreenTransform& _transform) override;
 
     void obbs(ScreenTransform& _transform, OBBBuffer& _obbs) override;
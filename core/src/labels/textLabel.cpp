@@ -7,6 +7,7 @@
 #include "log.h"
 #include "style/textStyle.h"
 #include "text/fontContext.h"
+#include "util/batchProjection.h"
 #include "util/geom.h"
 #include "view/view.h"
 
@@ -68,21 +69,26 @@ void TextLabel::applyAnchor(Anchor _anchor) {
     m_anchor = LabelProperty::anchorDirection(_anchor) * offset * 0.5f;
 }
 
-bool TextLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState& _viewState,
-                                      const AABB* _bounds, ScreenTransform& _transform) {
+void TextLabel::addProjectionPoints(const ViewState& _viewState, BatchProjection& _projection) {
+
+    m_projectionIndex = _projection.add(m_coordinates[0]);
 
-    bool clipped = false;
+    if (m_type == Type::line) {
+        _projection.add(m_coordinates[1]);
+        _projection.add((m_coordinates[0] + m_coordinates[1]) * 0.5f);
+    }
+}
+
+bool TextLabel::updateScreenTransform(const BatchProjection& _projection, const ViewState& _viewState,
+                                      const AABB* _bounds, ScreenTransform& _transform) {
 
     switch(m_type) {
         case Type::debug:
         case Type::point: {
 
-            glm::vec2 p0 = m_coordinates[0];
-
-            glm::vec2 screenPosition = worldToScreenSpace(_mvp, glm::vec4(p0, 0.0, 1.0),
-                                                          _viewState.viewportSize, clipped);
+            if (_projection.clipped(m_projectionIndex)) { return false; }
 
-            if (clipped) { return false; }
+            glm::vec2 screenPosition = _projection.screenPosition(m_projectionIndex);
 
             if (_bounds) {
                 auto aabb = m_options.anchors.extents(m_dim);
@@ -101,19 +107,17 @@ bool TextLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState& _v
 
             glm::vec2 rotation = {1, 0};
 
-            // project label position from mercator world space to screen
-            // coordinates
-            glm::vec2 p0 = m_coordinates[0];
-            glm::vec2 p2 = m_coordinates[1];
-
-            glm::vec2 ap0 = worldToScreenSpace(_mvp, glm::vec4(p0, 0.0, 1.0),
-                                               _viewState.viewportSize, clipped);
-            glm::vec2 ap2 = worldToScreenSpace(_mvp, glm::vec4(p2, 0.0, 1.0),
-                                               _viewState.viewportSize, clipped);
-
             // check whether the label is behind the camera using the
             // perspective division factor
-            if (clipped) { return false; }
+            if (_projection.clipped(m_projectionIndex) ||
+                _projection.clipped(m_projectionIndex + 1)) {
+                return false;
+            }
+
+            // label position projected from mercator world space to screen
+            // coordinates
+            glm::vec2 ap0 = _projection.screenPosition(m_projectionIndex);
+            glm::vec2 ap2 = _projection.screenPosition(m_projectionIndex + 1);
 
             if (_bounds) {
                 AABB aabb;
@@ -129,11 +133,8 @@ bool TextLabel::updateScreenTransform(const glm::mat4& _mvp, const ViewState& _v
 
             if (length < minLength) { return false; }
 
-            glm::vec2 p1 = glm::vec2(p2 + p0) * 0.5f;
-
             // Keep screen position center at world center (less sliding in tilted view)
-            glm::vec2 screenPosition = worldToScreenSpace(_mvp, glm::vec4(p1, 0.0, 1.0),
-                                                          _viewState.viewportSize, clipped);
+            glm::vec2 screenPosition = _projection.screenPosition(m_projectionIndex + 2);
 
             auto offset = m_options.offset;
 
@@ -1,13 +1,17 @@
 #include "map.h"
 
 #include "data/clientGeoJsonSource.h"
+#include "data/tileSource.h"
 #include "debug/textDisplay.h"
 #include "debug/frameInfo.h"
+#include "debug/tracer.h"
 #include "gl.h"
 #include "gl/glError.h"
 #include "gl/framebuffer.h"
+#include "gl/gpuMemory.h"
 #include "gl/hardware.h"
 #include "gl/primitives.h"
+#include "gl/programCache.h"
 #include "gl/renderState.h"
 #include "gl/shaderProgram.h"
 #include "labels/labels.h"
@@ -15,6 +19,7 @@
 #include "marker/markerManager.h"
 #include "platform.h"
 #include "scene/scene.h"
+#include "scene/sceneDiff.h"
 #include "scene/sceneLoader.h"
 #include "selection/selectionQuery.h"
 #include "style/material.h"
@@ -25,17 +30,25 @@
 #include "tile/tileManager.h"
 #include "util/asyncWorker.h"
 #include "util/fastmap.h"
+#include "util/histogram.h"
 #include "util/inputHandler.h"
 #include "util/ease.h"
 #include "util/jobQueue.h"
 #include "view/view.h"
 
+#include <algorithm>
 #include <bitset>
+#include <chrono>
 #include <cmath>
+#include <thread>
 
 namespace Tangram {
 
 const static size_t MAX_WORKERS = 2;
+const static size_t MAX_DECODERS = 1;
+
+// Time to wait for loading tiles between updates in renderOffscreen()
+const static int OFFSCREEN_UPDATE_INTERVAL_MS = 10;
 
 enum class EaseField { position, zoom, rotation, tilt };
 
@@ -46,10 +59,10 @@ public:
         platform(_platform),
         inputHandler(_platform, view),
         scene(std::make_shared<Scene>(_platform, Url())),
-        tileWorker(_platform, MAX_WORKERS),
+        tileWorker(_platform, MAX_WORKERS, MAX_DECODERS),
         tileManager(_platform, tileWorker) {}
 
-    void setScene(std::shared_ptr<Scene>& _scene);
+    void setScene(std::shared_ptr<Scene>& _scene, const SceneDiff* _diff = nullptr);
 
     void setEase(EaseField _f, Ease _e);
     void clearEase(EaseField _f);
@@ -87,6 +100,10 @@ public:
     MarkerManager markerManager;
     std::unique_ptr<FrameBuffer> selectionBuffer = std::make_unique<FrameBuffer>(0, 0);
 
+    // Render target of renderOffscreen()
+    std::unique_ptr<FrameBuffer> offscreenBuffer;
+    bool renderOffscreen = false;
+
     bool cacheGlState = false;
     float pickRadius = .5f;
 
@@ -94,6 +111,10 @@ public:
 
     SceneReadyCallback onSceneReady = nullptr;
 
+    // Time in ms spent in Map::update() and Map::render()
+    Histogram updateTime;
+    Histogram renderTime;
+
     void sceneLoadBegin() {
         sceneLoadTasks++;
     }
@@ -136,9 +157,31 @@ Map::~Map() {
     Primitives::deinit();
 }
 
-void Map::Impl::setScene(std::shared_ptr<Scene>& _scene) {
+void Map::Impl::setScene(std::shared_ptr<Scene>& _scene, const SceneDiff* _diff) {
+
+    // Take over what did not change when _scene is an update of the current scene
+    bool keepTiles = false;
+    bool workersUpdated = false;
+    if (_diff && scene && scene->id == _diff->prevSceneId) {
+        // reuse() moves the styles of the current scene into _scene and swaps
+        // their state: wait for workers building with them, and let workers
+        // continue only with the builders for _scene
+        tileWorker.runWhileIdle([&]() {
+            {
+                // Update tasks copy the config and programs of lastValidScene
+                std::lock_guard<std::mutex> lock(sceneMutex);
+                keepTiles = _diff->reuse(*scene, *_scene);
+            }
+            tileWorker.setScene(_scene);
+        });
+        workersUpdated = true;
+    }
 
-    scene = _scene;
+    {
+        // Guards reads of the current scene from other threads
+        std::lock_guard<std::mutex> lock(sceneMutex);
+        scene = _scene;
+    }
 
     scene->setPixelScale(view.pixelScale());
 
@@ -174,8 +217,14 @@ void Map::Impl::setScene(std::shared_ptr<Scene>& _scene) {
     }
 
     inputHandler.setView(view);
-    tileManager.setTileSources(_scene->tileSources());
-    tileWorker.setScene(_scene);
+    if (keepTiles) {
+        tileManager.updateTileSources(_scene->tileSources(), _diff->layerSources, _diff->rebuildAll);
+    } else {
+        tileManager.setTileSources(_scene->tileSources());
+    }
+    if (!workersUpdated) {
+        tileWorker.setScene(_scene);
+    }
     markerManager.setScene(_scene);
 
     bool animated = scene->animated() == Scene::animate::yes;
@@ -241,6 +290,47 @@ SceneID Map::loadSceneYaml(const std::string& _yaml, const std::string& _resourc
     return loadScene(scene, _sceneUpdates);
 }
 
+SceneID Map::loadSceneFrom(Map& _other) {
+
+    std::shared_ptr<Scene> otherScene;
+    std::shared_ptr<Scene> scene;
+    {
+        // Also keeps maps that load from _other in parallel from cloning its
+        // config at the same time
+        std::lock_guard<std::mutex> lock(_other.impl->sceneMutex);
+        otherScene = _other.impl->lastValidScene;
+
+        if (otherScene) {
+            scene = std::make_shared<Scene>(platform, otherScene->url());
+            scene->copyImportedConfig(*otherScene);
+            scene->useScenePosition = otherScene->useScenePosition;
+        }
+    }
+
+    if (!otherScene) {
+        scene = std::make_shared<Scene>();
+        if (impl->onSceneReady) {
+            SceneError err {{}, Error::no_valid_scene};
+            impl->onSceneReady(scene->id, &err);
+        }
+        return scene->id;
+    }
+
+    LOG("Loading scene of other map: %s", otherScene->url().string().c_str());
+
+    SceneID id = loadScene(scene);
+
+    // Tiles are requested on the next update, after the caches are shared
+    if (impl->scene == scene) {
+        for (auto& source : scene->tileSources()) {
+            if (auto otherSource = otherScene->getTileSource(source->name())) {
+                source->shareCache(*otherSource);
+            }
+        }
+    }
+    return id;
+}
+
 SceneID Map::loadSceneAsync(const std::string& _scenePath, bool _useScenePosition,
                             const std::vector<SceneUpdate>& _sceneUpdates) {
 
@@ -278,6 +368,9 @@ SceneID Map::loadSceneAsync(std::shared_ptr<Scene> nextScene,
                 return;
             }
 
+            // The current scene keeps rendering until the resources of nextScene are loaded
+            SceneLoader::waitForResources(*nextScene);
+
             {
                 std::lock_guard<std::mutex> lock(impl->sceneMutex);
                 // NB: Need to set the scene on the worker thread so that waiting
@@ -304,6 +397,11 @@ void Map::setSceneReadyListener(SceneReadyCallback _onSceneReady) {
     impl->onSceneReady = _onSceneReady;
 }
 
+SceneTiming Map::getSceneTiming() {
+    std::lock_guard<std::mutex> lock(impl->sceneMutex);
+    return impl->scene ? impl->scene->timing : SceneTiming();
+}
+
 std::shared_ptr<Platform>& Map::getPlatform() {
     return platform;
 }
@@ -328,9 +426,11 @@ SceneID Map::updateSceneAsync(const std::vector<SceneUpdate>& _sceneUpdates) {
                 return;
             }
 
+            std::shared_ptr<Scene> prevScene;
             {
                 std::lock_guard<std::mutex> lock(impl->sceneMutex);
-                nextScene->copyConfig(*impl->lastValidScene);
+                prevScene = impl->lastValidScene;
+                nextScene->copyConfig(*prevScene);
             }
 
             if (!SceneLoader::applyUpdates(platform, *nextScene, updates)) {
@@ -348,17 +448,27 @@ SceneID Map::updateSceneAsync(const std::vector<SceneUpdate>& _sceneUpdates) {
 
             bool configApplied = SceneLoader::applyConfig(platform, nextScene);
 
+            SceneDiff diff;
+            if (configApplied) {
+                SceneLoader::waitForResources(*nextScene);
+
+                diff = SceneDiff::compare(*prevScene, *nextScene);
+                LOGD("Scene update: %d sources, %d layer sources and %d styles changed, %d only in uniforms%s",
+                     int(diff.sources.size()), int(diff.layerSources.size()), int(diff.styles.size()),
+                     int(diff.uniformStyles.size()), diff.structural ? ", structural" : "");
+            }
+
             {
                 std::lock_guard<std::mutex> lock(impl->sceneMutex);
                 // NB: Need to set the scene on the worker thread so that waiting
                 // applyUpdates AsyncTasks can access it to copy the config.
                 if (configApplied) { impl->lastValidScene = nextScene; }
             }
-            impl->jobQueue.add([nextScene, configApplied, this]() {
+            impl->jobQueue.add([nextScene, configApplied, diff = std::move(diff), this]() {
 
                     if (configApplied) {
                         auto s = nextScene;
-                        impl->setScene(s);
+                        impl->setScene(s, &diff);
                     }
                     if (impl->onSceneReady) { impl->onSceneReady(nextScene->id, nullptr); }
                 });
@@ -391,6 +501,8 @@ void Map::resize(int _newWidth, int _newHeight) {
 
 bool Map::update(float _dt) {
 
+    TraceScope trace("update", "frame");
+
     impl->jobQueue.runJobs();
 
     // Wait until font and texture resources are fully loaded
@@ -401,6 +513,8 @@ bool Map::update(float _dt) {
 
     FrameInfo::beginUpdate();
 
+    auto updateStart = std::chrono::steady_clock::now();
+
     impl->scene->updateTime(_dt);
 
     bool viewComplete = true;
@@ -428,6 +542,17 @@ bool Map::update(float _dt) {
 
         impl->tileManager.updateTileSets(impl->view);
 
+        // Free cached tiles and then unused glyph atlases while GL resources
+        // exceed the memory budget
+        size_t overBudget = GPUMemory::overBudget();
+        if (overBudget > 0) {
+            overBudget -= std::min(overBudget, impl->tileManager.evictCachedTiles(overBudget));
+
+            if (overBudget > 0 && impl->scene->fontContext()) {
+                impl->scene->fontContext()->releaseUnusedAtlases();
+            }
+        }
+
         auto& tiles = impl->tileManager.getVisibleTiles();
         auto& markers = impl->markerManager.markers();
 
@@ -447,6 +572,9 @@ bool Map::update(float _dt) {
 
     FrameInfo::endUpdate();
 
+    impl->updateTime.record(std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - updateStart).count());
+
     bool viewChanged = impl->view.changedOnLastUpdate();
     bool tilesChanged = impl->tileManager.hasTileSetChanged();
     bool tilesLoading = impl->tileManager.hasLoadingTiles();
@@ -456,8 +584,9 @@ bool Map::update(float _dt) {
         viewComplete = false;
     }
 
-    // Request render if labels are in fading states or markers are easing.
-    if (labelsNeedUpdate || markersNeedUpdate) {
+    // Request render if labels are in fading states, markers are easing or
+    // loaded tiles wait for upload budget.
+    if (labelsNeedUpdate || markersNeedUpdate || impl->tileManager.pendingUploads() > 0) {
         platform->requestRender();
     }
 
@@ -493,6 +622,8 @@ void Map::render() {
         return;
     }
 
+    TraceScope trace("render", "frame");
+
     bool drawSelectionBuffer = getDebugFlag(DebugFlags::selection_buffer);
 
     // Cache default framebuffer handle used for rendering
@@ -500,6 +631,8 @@ void Map::render() {
 
     FrameInfo::beginFrame();
 
+    auto renderStart = std::chrono::steady_clock::now();
+
     // Invalidate render states for new frame
     if (!impl->cacheGlState) {
         impl->renderState.invalidate();
@@ -538,8 +671,16 @@ void Map::render() {
 
     // Setup default framebuffer for a new frame
     glm::vec2 viewport(impl->view.getWidth(), impl->view.getHeight());
-    FrameBuffer::apply(impl->renderState, impl->renderState.defaultFrameBuffer(),
-                       viewport, impl->scene->background().toColorF());
+    if (impl->renderOffscreen) {
+        if (!impl->offscreenBuffer->applyAsRenderTarget(impl->renderState,
+                                                        impl->scene->background().toColorF())) {
+            // renderOffscreen() reports the invalid framebuffer
+            return;
+        }
+    } else {
+        FrameBuffer::apply(impl->renderState, impl->renderState.defaultFrameBuffer(),
+                           viewport, impl->scene->background().toColorF());
+    }
 
     if (drawSelectionBuffer) {
         impl->selectionBuffer->drawDebug(impl->renderState, viewport);
@@ -550,6 +691,8 @@ void Map::render() {
     {
         std::lock_guard<std::mutex> lock(impl->tilesMutex);
 
+        Style::cullStats() = Style::CullStats();
+
         // Loop over all styles
         for (const auto& style : impl->scene->styles()) {
 
@@ -559,10 +702,25 @@ void Map::render() {
                         impl->markerManager.markers());
 
         }
+
+        if (Tracer::isEnabled()) {
+            // Trace the time from adding tiles until they were first drawn,
+            // which includes uploading their meshes
+            auto now = Tracer::now();
+            for (const auto& tile : impl->tileManager.getVisibleTiles()) {
+                if (tile->getTraceTime() > 0) {
+                    Tracer::span("wait for first draw", "tile", tile->getTraceTime(), now, tile->getID());
+                    tile->setTraceTime(0);
+                }
+            }
+        }
     }
 
     impl->labels.drawDebug(impl->renderState, impl->view);
 
+    impl->renderTime.record(std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - renderStart).count());
+
     FrameInfo::draw(impl->renderState, impl->view, impl->tileManager);
 }
 
@@ -582,6 +740,68 @@ void Map::captureSnapshot(unsigned int* _data) {
     GL::readPixels(0, 0, impl->view.getWidth(), impl->view.getHeight(), GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)_data);
 }
 
+RenderResult Map::renderOffscreen(int _width, int _height, std::vector<unsigned int>& _pixels, float _timeout) {
+
+    if (impl->view.getWidth() != _width || impl->view.getHeight() != _height) {
+        resize(_width, _height);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto lastUpdate = start;
+    bool complete = false;
+
+    while (true) {
+        auto now = Clock::now();
+        complete = update(std::chrono::duration<float>(now - lastUpdate).count());
+        lastUpdate = now;
+
+        if (complete || std::chrono::duration<float>(now - start).count() > _timeout) {
+            break;
+        }
+
+        // Tiles that wait for upload budget are added on the next update
+        if (impl->tileManager.pendingUploads() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(OFFSCREEN_UPDATE_INTERVAL_MS));
+        }
+    }
+
+    // render() would not draw at all while scene textures load, and labels
+    // would miss their fonts
+    if (impl->scene->pendingTextures > 0 || impl->scene->pendingFonts > 0) {
+        LOGE("Scene resources not loaded after %.1fs, cannot render", _timeout);
+        _pixels.clear();
+        return RenderResult::failed;
+    }
+
+    if (!complete) {
+        LOGW("View not complete after %.1fs, rendering it anyway", _timeout);
+    }
+
+    auto& buffer = impl->offscreenBuffer;
+    if (!buffer || buffer->getWidth() != _width || buffer->getHeight() != _height) {
+        buffer = std::make_unique<FrameBuffer>(_width, _height);
+    }
+
+    impl->renderOffscreen = true;
+    render();
+    impl->renderOffscreen = false;
+
+    if (!buffer->valid()) {
+        LOGE("Could not create offscreen framebuffer of %d x %d", _width, _height);
+        _pixels.clear();
+        return RenderResult::failed;
+    }
+
+    buffer->bind(impl->renderState);
+    _pixels = buffer->readRect(0, 0, 1, 1).pixels;
+
+    // Let the next render() find the platform framebuffer bound
+    impl->renderState.framebuffer(impl->renderState.defaultFrameBuffer());
+
+    return complete ? RenderResult::complete : RenderResult::incomplete;
+}
+
 void Map::Impl::setPositionNow(double _lon, double _lat) {
 
     glm::dvec2 meters = view.getMapProjection().LonLatToMeters({ _lon, _lat});
@@ -917,6 +1137,8 @@ void Map::setupGL() {
                                                               impl->selectionBuffer->getHeight());
     }
 
+    impl->offscreenBuffer.reset();
+
     // Set default primitive render color
     Primitives::setColor(impl->renderState, 0xffffff);
 
@@ -950,6 +1172,7 @@ void Map::onMemoryWarning() {
 
     if (impl->scene && impl->scene->fontContext()) {
         impl->scene->fontContext()->releaseFonts();
+        impl->scene->fontContext()->releaseUnusedAtlases();
     }
 }
 
@@ -957,6 +1180,106 @@ void Map::setDefaultBackgroundColor(float r, float g, float b) {
     impl->renderState.defaultOpaqueClearColor(r, g, b);
 }
 
+void Map::setGPUMemoryBudget(size_t _bytes) {
+    GPUMemory::setBudget(_bytes);
+}
+
+size_t Map::getGPUMemoryUsage() {
+    return GPUMemory::totalUsage();
+}
+
+static TimingMetrics timingMetrics(const Histogram& _histogram) {
+    TimingMetrics metrics;
+    metrics.count = _histogram.count();
+    metrics.mean = _histogram.mean();
+    metrics.p50 = _histogram.percentile(0.5f);
+    metrics.p90 = _histogram.percentile(0.9f);
+    metrics.p99 = _histogram.percentile(0.99f);
+    metrics.max = _histogram.max();
+    return metrics;
+}
+
+MapMetrics Map::getMetrics() {
+    MapMetrics metrics;
+
+    std::shared_ptr<Scene> scene;
+    {
+        std::lock_guard<std::mutex> lock(impl->sceneMutex);
+        scene = impl->scene;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(impl->tilesMutex);
+
+        auto& tileManager = impl->tileManager;
+        for (const auto& tile : tileManager.getVisibleTiles()) {
+            metrics.tilesVisible++;
+            if (tile->isProxy()) { metrics.tilesProxy++; }
+        }
+        metrics.tilesInProgress = tileManager.tilesInProgress();
+        metrics.tilesPendingUpload = tileManager.pendingUploads();
+
+        auto& tileCache = tileManager.getTileCache();
+        metrics.tileCacheEntries = tileCache->size();
+        metrics.tileCacheBytes = tileCache->getMemoryUsage();
+        metrics.tileCacheHits = tileCache->hits();
+        metrics.tileCacheMisses = tileCache->misses();
+
+        metrics.labels = impl->labels.labelCount();
+        metrics.labelsVisible = impl->labels.visibleLabelCount();
+    }
+
+    TileSource::CacheStats rawCache;
+    for (const auto& source : scene->tileSources()) {
+        source->cacheStats(rawCache);
+    }
+    metrics.rawCacheBytes = rawCache.bytes;
+    metrics.rawCacheHits = rawCache.hits;
+    metrics.rawCacheMisses = rawCache.misses;
+
+    metrics.workerQueueSize = impl->tileWorker.pendingTasks();
+    metrics.tileDecode = timingMetrics(impl->tileWorker.decodeTime());
+    metrics.tileBuild = timingMetrics(impl->tileWorker.buildTime());
+
+    metrics.labelCollision = timingMetrics(impl->labels.collisionTime());
+
+    if (auto& fontContext = scene->fontContext()) {
+        metrics.glyphAtlases = fontContext->glyphAtlasCount();
+    }
+
+    metrics.gpuMemory = GPUMemory::totalUsage();
+
+    metrics.frameUpdate = timingMetrics(impl->updateTime);
+    metrics.frameRender = timingMetrics(impl->renderTime);
+
+    return metrics;
+}
+
+void Map::resetMetrics() {
+    {
+        std::lock_guard<std::mutex> lock(impl->tilesMutex);
+        impl->tileManager.getTileCache()->resetStats();
+    }
+
+    std::shared_ptr<Scene> scene;
+    {
+        std::lock_guard<std::mutex> lock(impl->sceneMutex);
+        scene = impl->scene;
+    }
+    for (auto& source : scene->tileSources()) {
+        source->resetCacheStats();
+    }
+
+    impl->tileWorker.resetTimes();
+    impl->labels.collisionTime().reset();
+    impl->updateTime.reset();
+    impl->renderTime.reset();
+}
+
+void Map::setShaderCacheDirectory(const std::string& _directory) {
+    ProgramCache::setDirectory(_directory);
+}
+
 void setDebugFlag(DebugFlags _flag, bool _on) {
 
     g_flags.set(_flag, _on);
@@ -987,4 +1310,19 @@ void toggleDebugFlag(DebugFlags _flag) {
     // }
 }
 
+void setGlyphAtlasOptions(int _atlasSize, const std::string& _glyphCachePath) {
+    FontContext::Options options;
+    options.atlasSize = std::max(_atlasSize, 64);
+    options.glyphCachePath = _glyphCachePath;
+    FontContext::setDefaultOptions(options);
+}
+
+void setTraceEnabled(bool _enabled) {
+    Tracer::setEnabled(_enabled);
+}
+
+std::string getTraceJson() {
+    return Tracer::json();
+}
+
 }
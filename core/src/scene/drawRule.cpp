@@ -19,7 +19,26 @@ DrawRuleData::DrawRuleData(std::string _name, int _id,
                            std::vector<StyleParam> _parameters)
     : parameters(std::move(_parameters)),
       name(std::move(_name)),
-      id(_id) {}
+      id(_id) {
+
+    zoomParameters.resize(parameters.size());
+
+    for (size_t i = 0; i < parameters.size(); i++) {
+        const auto& param = parameters[i];
+        if (param.function >= 0 || !param.stops) { continue; }
+
+        auto& values = zoomParameters[i];
+        values.resize(maxCachedZoom + 1, param);
+        for (int zoom = 0; zoom <= maxCachedZoom; zoom++) {
+            Stops::eval(*param.stops, param.key, zoom, values[zoom].value);
+        }
+    }
+}
+
+const StyleParam* DrawRuleData::zoomParams(size_t _index) const {
+    const auto& values = zoomParameters[_index];
+    return values.empty() ? nullptr : values.data();
+}
 
 std::string DrawRuleData::toString() const {
     std::string str = "{\n";
@@ -39,10 +58,11 @@ DrawRule::DrawRule(const DrawRuleData& _ruleData, const std::string& _layerName,
     name(&_ruleData.name),
     id(_ruleData.id) {
 
-    for (const auto& param : _ruleData.parameters) {
+    for (size_t i = 0; i < _ruleData.parameters.size(); i++) {
+        const auto& param = _ruleData.parameters[i];
         auto key = static_cast<uint8_t>(param.key);
         active[key] = true;
-        params[key] = { &param, _layerName.c_str(), _layerDepth };
+        params[key] = { &param, _layerName.c_str(), _layerDepth, _ruleData.zoomParams(i) };
     }
 }
 
@@ -61,14 +81,15 @@ void DrawRule::merge(const DrawRuleData& _ruleData, const SceneLayer& _layer) {
     const auto depthNew = _layer.depth();
     const char* layerNew = _layer.name().c_str();
 
-    for (const auto& paramNew : _ruleData.parameters) {
+    for (size_t i = 0; i < _ruleData.parameters.size(); i++) {
 
+        const auto& paramNew = _ruleData.parameters[i];
         auto key = static_cast<uint8_t>(paramNew.key);
         auto& param = params[key];
 
         if (!active[key] || depthNew > param.depth ||
             (depthNew == param.depth && strcmp(layerNew, param.name) > 0)) {
-            param = { &paramNew, layerNew, depthNew };
+            param = { &paramNew, layerNew, depthNew, _ruleData.zoomParams(i) };
             active[key] = true;
         }
     }
@@ -162,6 +183,10 @@ bool DrawRuleMergeSet::evaluateRuleForContext(DrawRule& rule, StyleContext& ctx)
         return false;
     }
 
+    // The zoom at which Stops are evaluated is the same for all features of a tile
+    int zoom = ctx.getKeywordZoom();
+    bool cachedZoom = (zoom >= 0 && zoom <= DrawRuleData::maxCachedZoom);
+
     bool valid = true;
     for (size_t i = 0; i < StyleParamKeySize; ++i) {
 
@@ -187,6 +212,10 @@ bool DrawRuleMergeSet::evaluateRuleForContext(DrawRule& rule, StyleContext& ctx)
                     rule.active[i] = false;
                 }
             }
+        } else if (param->stops && cachedZoom && rule.params[i].zoomParams) {
+            // Point param to the value evaluated for this zoom when the rule was loaded.
+            param = &rule.params[i].zoomParams[zoom];
+
         } else if (param->stops) {
             m_evaluated[i] = *param;
             param = &m_evaluated[i];
@@ -200,17 +229,19 @@ bool DrawRuleMergeSet::evaluateRuleForContext(DrawRule& rule, StyleContext& ctx)
 
 void DrawRuleMergeSet::mergeRules(const SceneLayer& _layer) {
 
-    size_t pos, end = m_matchedRules.size();
-
     for (const auto& rule : _layer.rules()) {
-        for (pos = 0; pos < end; pos++) {
-            if (m_matchedRules[pos].id == rule.id) { break; }
+        size_t id = rule.id;
+        if (id >= m_ruleSlots.size()) {
+            m_ruleSlots.resize(id + 1, 0);
         }
 
-        if (pos == end) {
-            m_matchedRules.emplace_back(rule, _layer.name(), _layer.depth());
-        } else {
+        size_t& pos = m_ruleSlots[id];
+
+        if (pos < m_matchedRules.size() && m_matchedRules[pos].id == rule.id) {
             m_matchedRules[pos].merge(rule, _layer);
+        } else {
+            pos = m_matchedRules.size();
+            m_matchedRules.emplace_back(rule, _layer.name(), _layer.depth());
         }
     }
 }
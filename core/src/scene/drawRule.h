@@ -46,8 +46,19 @@ struct DrawRuleData {
     std::string name;
     int id;
 
+    // Parameters with Stops evaluated once for each integer zoom up to
+    // maxCachedZoom. Entries are parallel to 'parameters' and empty for
+    // parameters without Stops. Within a tile the zoom is constant, so
+    // these are shared by all features instead of evaluating the Stops
+    // for each of them.
+    static constexpr int maxCachedZoom = 24;
+    std::vector<std::vector<StyleParam>> zoomParameters;
+
     DrawRuleData(std::string _name, int _id, std::vector<StyleParam> _parameters);
 
+    // Values of parameters[_index] evaluated per zoom, or nullptr if it has no Stops
+    const StyleParam* zoomParams(size_t _index) const;
+
     std::string toString() const;
 
 };
@@ -62,6 +73,8 @@ struct DrawRule {
         // SceneLayer name and depth
         const char* name;
         size_t depth;
+        // Per-zoom values of 'param' when it has Stops, see DrawRuleData
+        const StyleParam* zoomParams;
 
     } params[StyleParamKeySize];
 
@@ -132,10 +145,18 @@ public:
     auto& matchedRules() { return m_matchedRules; }
 
 private:
-    // Reusable containers 'matchedRules' and 'queuedLayers'
+    // Reusable containers 'matchedRules' and 'queuedLayers'. These are
+    // cleared for each feature but keep their capacity, so that matching
+    // does not allocate once they have grown to fit the scene's layers.
     std::vector<DrawRule> m_matchedRules;
     std::vector<const SceneLayer*> m_queuedLayers;
 
+    // Position of the rule with a given DrawRule id in 'matchedRules'.
+    // Rule ids are dense indices assigned by the Scene. An entry is only
+    // valid when the rule at its position has the same id, so the table
+    // does not need to be reset between features.
+    std::vector<size_t> m_ruleSlots;
+
     // Container for dynamically-evaluated parameters
     StyleParam m_evaluated[StyleParamKeySize];
 
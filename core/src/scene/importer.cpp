@@ -2,6 +2,7 @@
 
 #include "log.h"
 #include "platform.h"
+#include "scene/sceneBinary.h"
 #include "scene/sceneLoader.h"
 #include "util/zipArchive.h"
 
@@ -27,7 +28,8 @@ Node Importer::applySceneImports(std::shared_ptr<Platform> platform) {
 
     if (!m_scene->yaml().empty()) {
         // Load scene from yaml string.
-        addSceneString(sceneUrl, m_scene->yaml());
+        m_requestedScenes.insert(sceneUrl);
+        addSceneNode(sceneUrl, loadSceneString(m_scene->yaml()));
     } else {
         // Load scene from yaml file.
         m_sceneQueue.push_back(sceneUrl);
@@ -55,8 +57,23 @@ Node Importer::applySceneImports(std::shared_ptr<Platform> platform) {
                 continue;
             }
 
-            if (m_importedScenes.find(nextUrlToImport) != m_importedScenes.end()) {
-                // This scene URL has already been imported, we're done!
+            // Scenes imported by several others are requested only once,
+            // also while the first request is still in flight
+            if (!m_requestedScenes.insert(nextUrlToImport).second) {
+                continue;
+            }
+        }
+
+        // Map scene bundles from local files instead of reading them into
+        // memory, their entries are decompressed when they are requested
+        if (isZipArchiveUrl(nextUrlToImport) &&
+            (nextUrlToImport.hasFileScheme() || !nextUrlToImport.hasScheme())) {
+            auto zipArchive = std::make_shared<ZipArchive>();
+            if (zipArchive->loadFromFile(nextUrlToImport.path())) {
+                Node sceneNode = loadSceneArchive(nextUrlToImport, zipArchive);
+
+                std::unique_lock<std::mutex> lock(sceneMutex);
+                addSceneNode(nextUrlToImport, sceneNode);
                 continue;
             }
         }
@@ -66,10 +83,17 @@ Node Importer::applySceneImports(std::shared_ptr<Platform> platform) {
             if (response.error) {
                 LOGE("Unable to retrieve '%s': %s", nextUrlToImport.string().c_str(), response.error);
             } else {
+                // Parse outside of the lock, so that responses arriving at the
+                // same time are parsed concurrently
+                Node sceneNode = loadSceneData(nextUrlToImport, response.content);
+
+                std::unique_lock<std::mutex> lock(sceneMutex);
+                addSceneNode(nextUrlToImport, sceneNode);
+            }
+            {
                 std::unique_lock<std::mutex> lock(sceneMutex);
-                addSceneData(nextUrlToImport, response.content);
+                activeDownloads--;
             }
-            activeDownloads--;
             condition.notify_all();
         });
     }
@@ -83,50 +107,61 @@ Node Importer::applySceneImports(std::shared_ptr<Platform> platform) {
     return root;
 }
 
-void Importer::addSceneData(const Url& sceneUrl, std::vector<char>& sceneContent) {
+Node Importer::loadSceneData(const Url& sceneUrl, std::vector<char>& sceneContent) {
 
     LOGD("Process: '%s'", sceneUrl.string().c_str());
 
-    // Don't load imports twice
-    if (m_importedScenes.find(sceneUrl) != m_importedScenes.end()) {
-        return;
+    if (SceneBinary::isSceneBinary(sceneContent)) {
+        // Precompiled scene, with its imports merged already
+        Node sceneNode;
+        if (!SceneBinary::read(sceneContent, sceneNode)) {
+            LOGE("Invalid scene binary '%s'", sceneUrl.string().c_str());
+        }
+        return sceneNode;
     }
 
-    std::string sceneString;
     if (isZipArchiveUrl(sceneUrl)) {
         // We're loading a scene from a zip archive!
         // First, create an archive from the data.
         auto zipArchive = std::make_shared<ZipArchive>();
-        zipArchive->loadFromMemory(sceneContent);
-        // Find the "base" scene file in the archive entries.
-        for (const auto& entry : zipArchive->entries()) {
-            auto ext = Url::getPathExtension(entry.path);
-            // The "base" scene file must have extension "yaml" or "yml" and be
-            // at the root directory of the archive (i.e. no '/' in path).
-            if ((ext == "yaml" || ext == "yml") && entry.path.find('/') == std::string::npos) {
-                // Found the base, now extract the contents to the scene string.
-                sceneString.resize(entry.uncompressedSize);
-                zipArchive->decompressEntry(&entry, &sceneString[0]);
-                break;
-            }
+        zipArchive->loadFromMemory(std::move(sceneContent));
+        return loadSceneArchive(sceneUrl, zipArchive);
+    }
+
+    return loadSceneString(std::string(sceneContent.data(), sceneContent.size()));
+}
+
+Node Importer::loadSceneArchive(const Url& sceneUrl, std::shared_ptr<ZipArchive> zipArchive) {
+
+    std::string sceneString;
+    // Find the "base" scene file in the archive entries.
+    for (const auto& entry : zipArchive->entries()) {
+        auto ext = Url::getPathExtension(entry.path);
+        // The "base" scene file must have extension "yaml" or "yml" and be
+        // at the root directory of the archive (i.e. no '/' in path).
+        if ((ext == "yaml" || ext == "yml") && entry.path.find('/') == std::string::npos) {
+            // Found the base, now extract the contents to the scene string.
+            sceneString.resize(entry.uncompressedSize);
+            zipArchive->decompressEntry(&entry, &sceneString[0]);
+            break;
         }
-        // Add the archive to the scene.
-        m_scene->addZipArchive(sceneUrl, zipArchive);
-    } else {
-        sceneString = std::string(sceneContent.data(), sceneContent.size());
     }
+    // Add the archive to the scene.
+    m_scene->addZipArchive(sceneUrl, zipArchive);
 
-    addSceneString(sceneUrl, sceneString);
+    return loadSceneString(sceneString);
 }
 
-void Importer::addSceneString(const Url& sceneUrl, const std::string& sceneString) {
-    Node sceneNode;
+Node Importer::loadSceneString(const std::string& sceneString) {
     try {
-        sceneNode = YAML::Load(sceneString);
+        return YAML::Load(sceneString);
     } catch (YAML::ParserException e) {
         LOGE("Parsing scene config '%s'", e.what());
-        return;
+        return Node();
     }
+}
+
+void Importer::addSceneNode(const Url& sceneUrl, const Node& sceneNode) {
 
     m_importedScenes[sceneUrl] = sceneNode;
 
@@ -8,11 +8,13 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Tangram {
 
 class Platform;
+class ZipArchive;
 
 class Importer {
 
@@ -39,11 +41,19 @@ public:
 
 protected:
 
-    // Process and store data for an imported scene from a vector of bytes.
-    void addSceneData(const Url& sceneUrl, std::vector<char>& sceneContent);
+    // Parse an imported scene from a vector of bytes of YAML, a zip archive or
+    // a SceneBinary. Zip archives are added to the scene. Safe to call
+    // concurrently for different scenes.
+    Node loadSceneData(const Url& sceneUrl, std::vector<char>& sceneContent);
 
-    // Process and store data for an imported scene from a string of YAML.
-    void addSceneString(const Url& sceneUrl, const std::string& sceneString);
+    // Parse the base scene of a zip archive and add the archive to the scene.
+    Node loadSceneArchive(const Url& sceneUrl, std::shared_ptr<ZipArchive> zipArchive);
+
+    // Parse an imported scene from a string of YAML.
+    static Node loadSceneString(const std::string& sceneString);
+
+    // Store a parsed scene and queue the scenes it imports.
+    void addSceneNode(const Url& sceneUrl, const Node& sceneNode);
 
     // Get the sequence of scene names that are designated to be imported into the
     // input scene node by its 'import' fields.
@@ -63,6 +73,9 @@ protected:
     std::unordered_map<Url, Node> m_importedScenes;
 
     std::vector<Url> m_sceneQueue;
+
+    // URLs of scenes that were requested, to not request them twice
+    std::unordered_set<Url> m_requestedScenes;
 };
 
 }
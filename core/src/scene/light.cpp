@@ -29,18 +29,22 @@ void Light::setInstanceName(const std::string &_name) {
 }
 
 void Light::setAmbientColor(const glm::vec4 _ambient) {
+    m_version++;
     m_ambient = _ambient;
 }
 
 void Light::setDiffuseColor(const glm::vec4 _diffuse) {
+    m_version++;
     m_diffuse = _diffuse;
 }
 
 void Light::setSpecularColor(const glm::vec4 _specular) {
+    m_version++;
     m_specular = _specular;
 }
 
 void Light::setOrigin(LightOrigin origin) {
+    m_version++;
     m_dynamic = true;
     m_origin = origin;
 }
@@ -102,6 +102,9 @@ public:
     static std::map<std::string, std::string>  assembleLights(const std::vector<std::unique_ptr<Light>>& _lights);
 
     bool isDynamic() const { return m_dynamic; }
+
+    /* Incremented whenever a property of the light changes */
+    uint32_t version() const { return m_version; }
 protected:
 
     /*  Get the uniform name of the DYNAMICAL light */
@@ -138,6 +141,8 @@ protected:
 
     bool m_dynamic;
 
+    uint32_t m_version = 1;
+
 };
 
 }
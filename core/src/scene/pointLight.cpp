@@ -22,19 +22,23 @@ PointLight::PointLight(const std::string& _name, bool _dynamic) :
 PointLight::~PointLight() {}
 
 void PointLight::setPosition(UnitVec<glm::vec3> pos) {
+    m_version++;
     m_position = pos;
 }
 
 void PointLight::setAttenuation(float _att) {
+    m_version++;
     m_attenuation = _att;
 }
 
 void PointLight::setRadius(float _outer) {
+    m_version++;
     m_innerRadius = 0.0;
     m_outerRadius = _outer;
 }
 
 void PointLight::setRadius(float _inner, float _outer) {
+    m_version++;
     m_innerRadius = _inner;
     m_outerRadius = _outer;
 }
@@ -27,7 +27,7 @@ Scene::Scene(std::shared_ptr<const Platform> _platform, const Url& _url)
     : id(s_serial++),
       m_url(_url),
       m_fontContext(std::make_shared<FontContext>(_platform)),
-      m_featureSelection(std::make_unique<FeatureSelection>()) {
+      m_featureSelection(std::make_shared<FeatureSelection>()) {
 
     // For now we only have one projection..
     // TODO how to share projection with view?
@@ -37,7 +37,7 @@ Scene::Scene(std::shared_ptr<const Platform> _platform, const Url& _url)
 Scene::Scene(std::shared_ptr<const Platform> _platform, const std::string& _yaml, const Url& _url)
     : id(s_serial++),
       m_fontContext(std::make_shared<FontContext>(_platform)),
-      m_featureSelection(std::make_unique<FeatureSelection>()) {
+      m_featureSelection(std::make_shared<FeatureSelection>()) {
 
     m_url = _url;
     m_yaml = _yaml;
@@ -47,7 +47,9 @@ Scene::Scene(std::shared_ptr<const Platform> _platform, const std::string& _yaml
 
 void Scene::copyConfig(const Scene& _other) {
 
-    m_featureSelection.reset(new FeatureSelection());
+    // Tiles that are kept across the update refer to the projection and
+    // draw selection colors from the same sequence
+    m_featureSelection = _other.m_featureSelection;
 
     m_config = YAML::Clone(_other.m_config);
     m_fontContext = _other.m_fontContext;
@@ -57,7 +59,28 @@ void Scene::copyConfig(const Scene& _other) {
 
     m_globalRefs = _other.m_globalRefs;
 
-    m_mapProjection.reset(new MercatorProjection());
+    m_mapProjection = _other.m_mapProjection;
+
+    m_zipArchives = _other.m_zipArchives;
+
+    for (auto& style : _other.m_styles) {
+        if (style->shaderProgram()) {
+            m_reusablePrograms.push_back(style->shaderProgram());
+        }
+        if (style->selectionProgram()) {
+            m_reusablePrograms.push_back(style->selectionProgram());
+        }
+    }
+}
+
+void Scene::copyImportedConfig(const Scene& _other) {
+
+    m_config = YAML::Clone(_other.m_config);
+
+    m_url = _other.m_url;
+    m_yaml = _other.m_yaml;
+
+    m_globalRefs = _other.m_globalRefs;
 
     m_zipArchives = _other.m_zipArchives;
 }
@@ -81,29 +104,58 @@ Style* Scene::findStyle(const std::string& _name) {
     return nullptr;
 }
 
+std::shared_ptr<ShaderProgram> Scene::findReusableProgram(const std::string& _vertSrc,
+                                                         const std::string& _fragSrc) const {
+
+    for (auto& program : m_reusablePrograms) {
+        if (program->vertexShaderSource() == _vertSrc &&
+            program->fragmentShaderSource() == _fragSrc) {
+            return program;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<ZipArchive> Scene::findZipArchive(const Url& url) {
+    // URL for a file in a zip archive, get the encoded source URL.
+    auto source = Importer::getArchiveUrlForZipEntry(url);
+    // Search for the source URL in our archive map.
+    std::lock_guard<std::mutex> lock(m_zipArchiveMutex);
+    auto it = m_zipArchives.find(source);
+    if (it == m_zipArchives.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+// Find the entry for a zip URL in the archive, returns an error message when
+// there is none.
+static const char* findZipEntry(const Url& url, const std::shared_ptr<ZipArchive>& archive,
+                                const ZipArchive::Entry*& entry) {
+    if (!archive) {
+        return "Could not find zip archive.";
+    }
+    auto zipEntryPath = url.path().substr(1);
+    entry = archive->findEntry(zipEntryPath);
+    if (!entry) {
+        return "Did not find zip archive entry.";
+    }
+    return nullptr;
+}
+
 UrlRequestHandle Scene::startUrlRequest(std::shared_ptr<Platform> platform, Url url, UrlCallback callback) {
     if (url.scheme() == "zip") {
         UrlResponse response;
-        // URL for a file in a zip archive, get the encoded source URL.
-        auto source = Importer::getArchiveUrlForZipEntry(url);
-        // Search for the source URL in our archive map.
-        auto it = m_zipArchives.find(source);
-        if (it != m_zipArchives.end()) {
-            auto& archive = it->second;
-            // Found the archive! Now create a response for the request.
-            auto zipEntryPath = url.path().substr(1);
-            auto entry = archive->findEntry(zipEntryPath);
-            if (entry) {
-                response.content.resize(entry->uncompressedSize);
-                bool success = archive->decompressEntry(entry, response.content.data());
-                if (!success) {
-                    response.error = "Unable to decompress zip archive file.";
-                }
-            } else {
-                response.error = "Did not find zip archive entry.";
+        auto archive = findZipArchive(url);
+        const ZipArchive::Entry* entry = nullptr;
+        response.error = findZipEntry(url, archive, entry);
+        if (!response.error) {
+            // Found the entry! Now create a response for the request.
+            response.content.resize(entry->uncompressedSize);
+            bool success = archive->decompressEntry(entry, response.content.data());
+            if (!success) {
+                response.error = "Unable to decompress zip archive file.";
             }
-        } else {
-            response.error = "Could not find zip archive.";
         }
         callback(response);
         return 0;
@@ -113,10 +165,41 @@ UrlRequestHandle Scene::startUrlRequest(std::shared_ptr<Platform> platform, Url
     return platform->startUrlRequest(url, callback);
 }
 
+const char* Scene::readZipEntry(const Url& url, std::function<void(const char* data, size_t size)> consumer) {
+    auto archive = findZipArchive(url);
+    const ZipArchive::Entry* entry = nullptr;
+    if (auto error = findZipEntry(url, archive, entry)) {
+        return error;
+    }
+    if (entry->storedData) {
+        consumer(entry->storedData, entry->uncompressedSize);
+        return nullptr;
+    }
+    std::vector<char> content(entry->uncompressedSize);
+    if (!archive->decompressEntry(entry, content.data())) {
+        return "Unable to decompress zip archive file.";
+    }
+    consumer(content.data(), content.size());
+    return nullptr;
+}
+
 void Scene::addZipArchive(Url url, std::shared_ptr<ZipArchive> zipArchive) {
+    std::lock_guard<std::mutex> lock(m_zipArchiveMutex);
     m_zipArchives.emplace(url, zipArchive);
 }
 
+void Scene::resourceLoaded() {
+    // Taking the lock orders the notification after a waiting thread
+    // checked the pending counts
+    { std::lock_guard<std::mutex> lock(m_resourceMutex); }
+    m_resourceCondition.notify_all();
+}
+
+void Scene::waitForResources() {
+    std::unique_lock<std::mutex> lock(m_resourceMutex);
+    m_resourceCondition.wait(lock, [&]{ return pendingTextures == 0 && pendingFonts == 0; });
+}
+
 int Scene::addIdForName(const std::string& _name) {
     int id = getIdForName(_name);
 
@@ -8,6 +8,7 @@
 #include "view/view.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -28,6 +29,7 @@ class Light;
 class MapProjection;
 class Platform;
 class SceneLayer;
+class ShaderProgram;
 class Style;
 class Texture;
 class TileSource;
@@ -77,6 +79,12 @@ public:
 
     void copyConfig(const Scene& _other);
 
+    // Copy the imported config of _other and the archives it refers to, but
+    // none of the state created from it. SceneLoader::loadScene() then applies
+    // the config without importing it again, e.g. for a Map with another GL
+    // context than the one of _other.
+    void copyImportedConfig(const Scene& _other);
+
     auto& camera() { return m_camera; }
     auto& config() { return m_config; }
     auto& tileSources() { return m_tileSources; }
@@ -91,6 +99,7 @@ public:
     auto& fontContext() { return m_fontContext; }
     auto& globalRefs() { return m_globalRefs; }
     auto& featureSelection() { return m_featureSelection; }
+    auto& reusablePrograms() { return m_reusablePrograms; }
     Style* findStyle(const std::string& _name);
 
     const auto& url() const { return m_url; }
@@ -111,6 +120,11 @@ public:
 
     const Light* findLight(const std::string& _name) const;
 
+    // Returns a program of the scene this config was copied from with the
+    // same shader source, or nullptr
+    std::shared_ptr<ShaderProgram> findReusableProgram(const std::string& _vertSrc,
+                                                       const std::string& _fragSrc) const;
+
     // Start an asynchronous request for the scene resource at the given URL.
     // In addition to the URL types supported by the platform instance, this
     // also supports a custom ZIP URL scheme. ZIP URLs are of the form:
@@ -123,6 +137,11 @@ public:
     // requested.
     UrlRequestHandle startUrlRequest(std::shared_ptr<Platform> platform, Url url, UrlCallback callback);
 
+    // Pass the data of the file at a ZIP URL to the consumer, synchronously.
+    // Files stored in the archive without compression are passed straight from
+    // the archive data, without copying them. Returns an error message or null.
+    const char* readZipEntry(const Url& url, std::function<void(const char* data, size_t size)> consumer);
+
     void addZipArchive(Url url, std::shared_ptr<ZipArchive> zipArchive);
 
     void updateTime(float _dt) { m_time += _dt; }
@@ -151,8 +170,17 @@ public:
     std::atomic_ushort pendingTextures{0};
     std::atomic_ushort pendingFonts{0};
 
+    // Wakes waitForResources(), to be called after pendingTextures or
+    // pendingFonts were decremented
+    void resourceLoaded();
+
+    // Blocks until there are no pending textures and fonts
+    void waitForResources();
+
     std::vector<SceneError> errors;
 
+    SceneTiming timing;
+
 private:
 
     // The URL from which this scene was loaded
@@ -163,7 +191,7 @@ private:
     // The root node of the YAML scene configuration
     YAML::Node m_config;
 
-    std::unique_ptr<MapProjection> m_mapProjection;
+    std::shared_ptr<MapProjection> m_mapProjection;
 
     std::vector<DataLayer> m_layers;
     std::vector<std::shared_ptr<TileSource>> m_tileSources;
@@ -179,6 +207,14 @@ private:
     // value is a ZipArchive initialized with the compressed archive data.
     std::unordered_map<Url, std::shared_ptr<ZipArchive>> m_zipArchives;
 
+    // Get the archive that a ZIP URL refers to, or null
+    std::shared_ptr<ZipArchive> findZipArchive(const Url& url);
+    // Archives are added while imports are requested from other threads
+    std::mutex m_zipArchiveMutex;
+
+    std::mutex m_resourceMutex;
+    std::condition_variable m_resourceCondition;
+
     // Records the YAML Nodes for which global values have been swapped; keys are
     // nodes that referenced globals, values are nodes of globals themselves.
     std::vector<std::pair<YamlPath, YamlPath>> m_globalRefs;
@@ -195,7 +231,11 @@ private:
 
     std::shared_ptr<FontContext> m_fontContext;
 
-    std::unique_ptr<FeatureSelection> m_featureSelection;
+    std::shared_ptr<FeatureSelection> m_featureSelection;
+
+    // Programs of the scene this config was copied from, kept until the
+    // styles of this scene are built
+    std::vector<std::shared_ptr<ShaderProgram>> m_reusablePrograms;
 
     animate m_animated = none;
 
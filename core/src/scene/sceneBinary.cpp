@@ -0,0 +1,181 @@
+#include "scene/sceneBinary.h"
+
+#include "yaml-cpp/yaml.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace Tangram {
+
+static const char magic[] = { 'T', 'G', 'S', 'B' };
+
+enum class NodeTag : char {
+    null = 0,
+    scalar,
+    sequence,
+    map,
+};
+
+struct Writer {
+    std::vector<char> strings;
+    std::vector<char> nodes;
+    std::unordered_map<std::string, uint32_t> stringIds;
+
+    static void varint(std::vector<char>& _out, uint32_t _value) {
+        while (_value >= 0x80) {
+            _out.push_back(char((_value & 0x7f) | 0x80));
+            _value >>= 7;
+        }
+        _out.push_back(char(_value));
+    }
+
+    void string(const std::string& _string) {
+        auto it = stringIds.find(_string);
+        if (it == stringIds.end()) {
+            it = stringIds.emplace(_string, stringIds.size()).first;
+            varint(strings, _string.size());
+            strings.insert(strings.end(), _string.begin(), _string.end());
+        }
+        varint(nodes, it->second);
+    }
+
+    void node(const YAML::Node& _node) {
+        switch (_node.Type()) {
+        case YAML::NodeType::Scalar:
+            nodes.push_back(char(NodeTag::scalar));
+            string(_node.Tag());
+            string(_node.Scalar());
+            break;
+        case YAML::NodeType::Sequence:
+            nodes.push_back(char(NodeTag::sequence));
+            varint(nodes, _node.size());
+            for (const auto& entry : _node) {
+                node(entry);
+            }
+            break;
+        case YAML::NodeType::Map:
+            nodes.push_back(char(NodeTag::map));
+            varint(nodes, _node.size());
+            for (const auto& entry : _node) {
+                node(entry.first);
+                node(entry.second);
+            }
+            break;
+        default:
+            nodes.push_back(char(NodeTag::null));
+            break;
+        }
+    }
+};
+
+struct Reader {
+    const char* pos;
+    const char* end;
+    std::vector<std::string> strings;
+
+    bool varint(uint32_t& _value) {
+        _value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (pos == end) { return false; }
+            uint8_t byte = *pos++;
+            _value |= uint32_t(byte & 0x7f) << shift;
+            if (byte < 0x80) { return true; }
+        }
+        return false;
+    }
+
+    bool string(const std::string*& _string) {
+        uint32_t id;
+        if (!varint(id) || id >= strings.size()) { return false; }
+        _string = &strings[id];
+        return true;
+    }
+
+    bool node(YAML::Node& _node, int _depth = 0) {
+        if (pos == end || _depth > SceneBinary::maxDepth) { return false; }
+
+        uint32_t count;
+        switch (NodeTag(*pos++)) {
+        case NodeTag::null:
+            _node = YAML::Node(YAML::NodeType::Null);
+            return true;
+        case NodeTag::scalar: {
+            const std::string* tag;
+            const std::string* value;
+            if (!string(tag) || !string(value)) { return false; }
+            _node = YAML::Node(*value);
+            _node.SetTag(*tag);
+            return true;
+        }
+        case NodeTag::sequence:
+            if (!varint(count)) { return false; }
+            _node = YAML::Node(YAML::NodeType::Sequence);
+            for (uint32_t i = 0; i < count; i++) {
+                YAML::Node entry;
+                if (!node(entry, _depth + 1)) { return false; }
+                _node.push_back(entry);
+            }
+            return true;
+        case NodeTag::map:
+            if (!varint(count)) { return false; }
+            _node = YAML::Node(YAML::NodeType::Map);
+            for (uint32_t i = 0; i < count; i++) {
+                YAML::Node key, value;
+                if (!node(key, _depth + 1) || !node(value, _depth + 1)) { return false; }
+                _node.force_insert(key, value);
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+};
+
+bool SceneBinary::isSceneBinary(const std::vector<char>& _data) {
+    return _data.size() >= sizeof(magic) && std::memcmp(_data.data(), magic, sizeof(magic)) == 0;
+}
+
+std::vector<char> SceneBinary::write(const YAML::Node& _config) {
+
+    Writer writer;
+    writer.node(_config);
+
+    std::vector<char> out(magic, magic + sizeof(magic));
+    Writer::varint(out, version);
+    Writer::varint(out, writer.stringIds.size());
+    out.insert(out.end(), writer.strings.begin(), writer.strings.end());
+    out.insert(out.end(), writer.nodes.begin(), writer.nodes.end());
+
+    return out;
+}
+
+bool SceneBinary::read(const std::vector<char>& _data, YAML::Node& _config) {
+
+    if (!isSceneBinary(_data)) { return false; }
+
+    Reader reader;
+    reader.pos = _data.data() + sizeof(magic);
+    reader.end = _data.data() + _data.size();
+
+    uint32_t fileVersion, stringCount;
+    if (!reader.varint(fileVersion) || fileVersion != version) { return false; }
+    if (!reader.varint(stringCount)) { return false; }
+
+    reader.strings.reserve(std::min<size_t>(stringCount, _data.size()));
+    for (uint32_t i = 0; i < stringCount; i++) {
+        uint32_t length;
+        if (!reader.varint(length) || length > size_t(reader.end - reader.pos)) { return false; }
+        reader.strings.emplace_back(reader.pos, length);
+        reader.pos += length;
+    }
+
+    YAML::Node config;
+    if (!reader.node(config) || reader.pos != reader.end) { return false; }
+
+    _config = config;
+    return true;
+}
+
+}
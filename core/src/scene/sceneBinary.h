@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace YAML {
+    class Node;
+}
+
+namespace Tangram {
+
+/* Compact binary encoding of a scene config, with its imports merged and
+ * URLs resolved, so that loading a scene does not need to parse YAML.
+ * Written by the sceneCompiler tool from the YAML scene that stays the
+ * authoring format; the Importer reads it in place of a scene file.
+ *
+ * Layout, with integers as unsigned LEB128 varints:
+ *   "TGSB", version
+ *   number of strings, strings as length and bytes
+ *   root node
+ * where a node is its type byte followed by
+ *   Scalar: index of its tag and of its value in the strings
+ *   Sequence: number of entries, entry nodes
+ *   Map: number of entries, key and value node of each entry
+ */
+class SceneBinary {
+
+public:
+
+    static constexpr uint32_t version = 1;
+
+    // Nesting of sequences and maps that read() accepts, deeper binaries are
+    // rejected instead of exhausting the stack
+    static constexpr int maxDepth = 128;
+
+    // Whether _data starts with the magic bytes of a scene binary
+    static bool isSceneBinary(const std::vector<char>& _data);
+
+    static std::vector<char> write(const YAML::Node& _config);
+
+    // Returns false when _data is not a scene binary of this version, is
+    // truncated or nests deeper than maxDepth
+    static bool read(const std::vector<char>& _data, YAML::Node& _config);
+
+};
+
+}
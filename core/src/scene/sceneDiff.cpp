@@ -0,0 +1,274 @@
+#include "scene/sceneDiff.h"
+
+#include "data/tileSource.h"
+#include "scene/scene.h"
+#include "style/pointStyle.h"
+#include "style/style.h"
+
+#include "yaml-cpp/yaml.h"
+
+#include <utility>
+
+namespace Tangram {
+
+bool SceneDiff::isEqual(const Node& _a, const Node& _b) {
+
+    if (!_a.IsDefined() || !_b.IsDefined()) {
+        return _a.IsDefined() == _b.IsDefined();
+    }
+    if (_a.is(_b)) { return true; }
+    if (_a.Type() != _b.Type()) { return false; }
+
+    switch (_a.Type()) {
+    case YAML::NodeType::Scalar:
+        return _a.Scalar() == _b.Scalar();
+    case YAML::NodeType::Sequence:
+        if (_a.size() != _b.size()) { return false; }
+        for (size_t i = 0; i < _a.size(); i++) {
+            if (!isEqual(_a[i], _b[i])) { return false; }
+        }
+        return true;
+    case YAML::NodeType::Map:
+        if (_a.size() != _b.size()) { return false; }
+        for (const auto& entry : _a) {
+            if (!entry.first.IsScalar()) { return false; }
+            if (!isEqual(entry.second, _b[entry.first.Scalar()])) { return false; }
+        }
+        return true;
+    default:
+        return true;
+    }
+}
+
+// Collect the names of entries that differ between the maps _a and _b.
+// Returns false when one of them is not a map.
+static bool changedEntries(const YAML::Node& _a, const YAML::Node& _b, std::set<std::string>& _out) {
+
+    if ((_a && !_a.IsMap()) || (_b && !_b.IsMap())) { return false; }
+
+    if (_a) {
+        for (const auto& entry : _a) {
+            const auto& name = entry.first.Scalar();
+            if (!_b || !SceneDiff::isEqual(entry.second, _b[name])) { _out.insert(name); }
+        }
+    }
+    if (_b) {
+        for (const auto& entry : _b) {
+            const auto& name = entry.first.Scalar();
+            if (!_a || !_a[name]) { _out.insert(name); }
+        }
+    }
+    return true;
+}
+
+// Whether the style configs _a and _b differ at most in the values of their
+// uniforms; the uniforms must have the same names in the same order.
+static bool differInUniformsOnly(const YAML::Node& _a, const YAML::Node& _b) {
+
+    if (!_a || !_b || !_a.IsMap() || !_b.IsMap() || _a.size() != _b.size()) { return false; }
+
+    for (const auto& entry : _a) {
+        const auto& key = entry.first.Scalar();
+        if (key != "shaders") {
+            if (!SceneDiff::isEqual(entry.second, _b[key])) { return false; }
+            continue;
+        }
+
+        const YAML::Node& shaders = entry.second;
+        const YAML::Node& other = _b[key];
+        if (!other || !shaders.IsMap() || !other.IsMap() || shaders.size() != other.size()) { return false; }
+
+        for (const auto& shaderEntry : shaders) {
+            const auto& shaderKey = shaderEntry.first.Scalar();
+            if (shaderKey != "uniforms") {
+                if (!SceneDiff::isEqual(shaderEntry.second, other[shaderKey])) { return false; }
+                continue;
+            }
+
+            const YAML::Node& uniforms = shaderEntry.second;
+            const YAML::Node& otherUniforms = other[shaderKey];
+            if (!otherUniforms || !uniforms.IsMap() || !otherUniforms.IsMap() ||
+                uniforms.size() != otherUniforms.size()) { return false; }
+
+            auto it = otherUniforms.begin();
+            for (const auto& uniform : uniforms) {
+                if (uniform.first.Scalar() != it->first.Scalar()) { return false; }
+                ++it;
+            }
+        }
+    }
+    return true;
+}
+
+static size_t uniformArraySize(const UniformValue& _value) {
+    if (_value.is<UniformArray1f>()) { return _value.get<UniformArray1f>().size(); }
+    if (_value.is<UniformArray2f>()) { return _value.get<UniformArray2f>().size(); }
+    if (_value.is<UniformArray3f>()) { return _value.get<UniformArray3f>().size(); }
+    if (_value.is<UniformTextureArray>()) { return _value.get<UniformTextureArray>().names.size(); }
+    return 0;
+}
+
+// Uniform declarations are generated from the type of the values, so that
+// styles with the same uniform types share their shader source
+static bool sameUniformTypes(Style& _a, Style& _b) {
+
+    auto& a = _a.styleUniforms();
+    auto& b = _b.styleUniforms();
+    if (a.size() != b.size()) { return false; }
+
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].second.which() != b[i].second.which() ||
+            uniformArraySize(a[i].second) != uniformArraySize(b[i].second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SceneDiff SceneDiff::compare(const Scene& _prev, const Scene& _next) {
+
+    SceneDiff diff;
+    diff.prevSceneId = _prev.id;
+
+    const Node& prev = _prev.config();
+    const Node& next = _next.config();
+
+    std::set<std::string> keys;
+    for (const auto& entry : prev) { keys.insert(entry.first.Scalar()); }
+    for (const auto& entry : next) { keys.insert(entry.first.Scalar()); }
+
+    for (const auto& key : keys) {
+        const Node& a = prev[key];
+        const Node& b = next[key];
+
+        if (isEqual(a, b)) { continue; }
+
+        if (key == "sources") {
+            if (!changedEntries(a, b, diff.sources)) { diff.structural = true; }
+
+        } else if (key == "layers") {
+            std::set<std::string> layers;
+            if (!changedEntries(a, b, layers)) {
+                diff.structural = true;
+                continue;
+            }
+            for (const auto& name : layers) {
+                for (const Node& layers : { a, b }) {
+                    if (!layers || !layers[name]) { continue; }
+
+                    const Node& data = layers[name]["data"];
+                    if (data && data["source"] && data["source"].IsScalar()) {
+                        diff.layerSources.insert(data["source"].Scalar());
+                    } else {
+                        diff.rebuildAll = true;
+                    }
+                }
+            }
+
+        } else if (key == "styles") {
+            std::set<std::string> styles;
+            if (!changedEntries(a, b, styles)) {
+                diff.structural = true;
+                continue;
+            }
+            for (const auto& name : styles) {
+                if (a && b && differInUniformsOnly(a[name], b[name])) {
+                    diff.uniformStyles.insert(name);
+                } else {
+                    diff.styles.insert(name);
+                }
+            }
+
+        } else if (key == "global") {
+            // Global references are already resolved in the config, but
+            // JS functions may read globals as well
+            diff.rebuildAll = true;
+
+        } else if (key == "camera" || key == "cameras" || key == "scene" || key == "import") {
+            // Read from the scene when rendering, or only used for importing
+
+        } else {
+            diff.structural = true;
+        }
+    }
+
+    // Sources with changed raster sources are loaded again
+    if (!diff.sources.empty() && next["sources"] && next["sources"].IsMap()) {
+        bool added = true;
+        while (added) {
+            added = false;
+            for (const auto& entry : next["sources"]) {
+                const auto& name = entry.first.Scalar();
+                if (diff.sources.count(name) != 0) { continue; }
+
+                if (!entry.second.IsMap()) { continue; }
+
+                const Node& rasters = entry.second["rasters"];
+                if (!rasters || !rasters.IsSequence()) { continue; }
+
+                for (const auto& raster : rasters) {
+                    if (diff.sources.count(raster.Scalar()) != 0) {
+                        diff.sources.insert(name);
+                        added = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return diff;
+}
+
+bool SceneDiff::reuse(Scene& _prev, Scene& _next) const {
+
+    // Take over unchanged sources with the data they loaded
+    for (auto& source : _next.tileSources()) {
+        if (sources.count(source->name()) != 0) { continue; }
+
+        auto prevSource = _prev.getTileSource(source->name());
+        if (!prevSource) { continue; }
+
+        prevSource->generateGeometry(source->generateGeometry());
+        source = prevSource;
+    }
+
+    if (!keepsTiles()) { return false; }
+
+    auto& prevStyles = _prev.styles();
+    auto& nextStyles = _next.styles();
+
+    if (prevStyles.size() != nextStyles.size()) { return false; }
+
+    for (size_t i = 0; i < nextStyles.size(); i++) {
+        const auto& name = nextStyles[i]->getName();
+        if (prevStyles[i]->getName() != name) { return false; }
+
+        if (uniformStyles.count(name) != 0 &&
+            !sameUniformTypes(*prevStyles[i], *nextStyles[i])) {
+            return false;
+        }
+    }
+
+    // Meshes of the tiles of _prev refer to its styles and the styles to its
+    // lights: Move both into _next, with the state loaded for _next
+    for (size_t i = 0; i < nextStyles.size(); i++) {
+        prevStyles[i]->swapSceneState(*nextStyles[i]);
+        std::swap(prevStyles[i], nextStyles[i]);
+    }
+    std::swap(_prev.lights(), _next.lights());
+
+    // Sprites of the kept tiles refer to the textures of _prev
+    for (auto& texture : _prev.textures()) {
+        _next.textures()[texture.first] = texture.second;
+    }
+    for (auto& style : nextStyles) {
+        if (auto pointStyle = dynamic_cast<PointStyle*>(style.get())) {
+            pointStyle->setTextures(_next.textures());
+        }
+    }
+
+    return true;
+}
+
+}
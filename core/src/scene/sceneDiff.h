@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+
+namespace YAML {
+    class Node;
+}
+
+namespace Tangram {
+
+class Scene;
+
+/* SceneDiff classifies the changes between the config of a scene and the
+ * config of a scene that was updated from it, see Map::updateSceneAsync.
+ *
+ * Tile sources whose config did not change are taken over with the data they
+ * already loaded. When styles differ at most in uniform values and lights,
+ * textures and fonts did not change, the styles are taken over as well, so
+ * that tiles can be kept and only those of sources used by changed layers
+ * are built again.
+ */
+struct SceneDiff {
+
+    using Node = YAML::Node;
+
+    // Id of the scene that the update was compared against
+    int32_t prevSceneId = -1;
+
+    // Sources whose config, or the config of one of their raster sources, changed
+    std::set<std::string> sources;
+
+    // Sources used by layers that changed, were added or removed
+    std::set<std::string> layerSources;
+
+    // Styles that changed, were added or removed
+    std::set<std::string> styles;
+
+    // Styles that changed only in the values of their uniforms
+    std::set<std::string> uniformStyles;
+
+    // Change that tiles may depend on in any way, e.g. to globals that
+    // JS functions can read
+    bool rebuildAll = false;
+
+    // Lights, textures, fonts or unknown parts of the config changed
+    bool structural = false;
+
+    bool empty() const {
+        return sources.empty() && layerSources.empty() && styles.empty() &&
+            uniformStyles.empty() && !rebuildAll && !structural;
+    }
+
+    // Returns whether tiles of _prev stay valid with the styles of _next
+    // after reuse(), i.e. they can be kept until rebuilt.
+    bool keepsTiles() const { return !structural && styles.empty(); }
+
+    static SceneDiff compare(const Scene& _prev, const Scene& _next);
+
+    // Take over tile sources with unchanged config from _prev into _next, and
+    // when keepsTiles() also the styles and lights. Returns false when tiles
+    // of _prev must be dropped. Must be called on the render thread, before
+    // _next replaces _prev.
+    bool reuse(Scene& _prev, Scene& _next) const;
+
+    static bool isEqual(const Node& _a, const Node& _b);
+
+};
+
+}
@@ -27,6 +27,7 @@
 #include "scene/stops.h"
 #include "scene/styleMixer.h"
 #include "scene/styleParam.h"
+#include "util/asyncWorker.h"
 #include "util/base64.h"
 #include "util/floatFormatter.h"
 #include "util/yamlHelper.h"
@@ -39,6 +40,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <iterator>
 #include <regex>
 #include <vector>
@@ -56,12 +58,39 @@ constexpr size_t CACHE_SIZE = 16 * (1024 * 1024);
 
 static const std::string GLOBAL_PREFIX = "global.";
 
+static float elapsedMs(std::chrono::steady_clock::time_point _start) {
+    auto elapsed = std::chrono::steady_clock::now() - _start;
+    return std::chrono::duration<float, std::milli>(elapsed).count();
+}
+
+// Decodes textures and loads fonts of scenes, so that their URL responses
+// are processed in parallel and off the threads of the platform URL client
+static AsyncWorker& resourceWorker() {
+    static AsyncWorker worker(std::max(2u, std::thread::hardware_concurrency()));
+    return worker;
+}
+
 bool SceneLoader::loadScene(const std::shared_ptr<Platform>& _platform, std::shared_ptr<Scene> _scene,
                             const std::vector<SceneUpdate>& _updates) {
 
-    Importer sceneImporter(_scene);
+    auto start = std::chrono::steady_clock::now();
 
-    _scene->config() = sceneImporter.applySceneImports(_platform);
+    // Load system font resources while the scene is imported
+    _scene->pendingFonts++;
+    resourceWorker().enqueue([_scene]() {
+        _scene->fontContext()->loadFonts();
+        _scene->pendingFonts--;
+        _scene->resourceLoaded();
+    });
+
+    // The config of a scene that copied an imported config is complete
+    if (!_scene->config().IsMap()) {
+        Importer sceneImporter(_scene);
+
+        _scene->config() = sceneImporter.applySceneImports(_platform);
+
+        _scene->timing.import = elapsedMs(start);
+    }
 
     if (!_scene->config()) {
         return false;
@@ -72,11 +101,13 @@ bool SceneLoader::loadScene(const std::shared_ptr<Platform>& _platform, std::sha
         return false;
     }
 
-    // Load font resources
-    _scene->fontContext()->loadFonts();
+    // Fonts of the scene use the system fonts as fallbacks
+    _scene->waitForResources();
 
     applyConfig(_platform, _scene);
 
+    LOGD("Scene loaded: import %.1fms, config %.1fms", _scene->timing.import, _scene->timing.config);
+
     return true;
 }
 
@@ -177,6 +208,8 @@ void SceneLoader::applyGlobals(Node root, Scene& scene) {
 
 bool SceneLoader::applyConfig(const std::shared_ptr<Platform>& _platform, const std::shared_ptr<Scene>& _scene) {
 
+    auto start = std::chrono::steady_clock::now();
+
     Node& config = _scene->config();
 
     // Instantiate built-in styles
@@ -309,10 +342,23 @@ bool SceneLoader::applyConfig(const std::shared_ptr<Platform>& _platform, const
     for (auto& style : _scene->styles()) {
         style->build(*_scene);
     }
+    _scene->reusablePrograms().clear();
+
+    _scene->timing.config = elapsedMs(start);
 
     return true;
 }
 
+void SceneLoader::waitForResources(Scene& _scene) {
+    auto start = std::chrono::steady_clock::now();
+
+    _scene.waitForResources();
+
+    _scene.timing.resources = elapsedMs(start);
+
+    LOGD("Scene resources loaded: %.1fms", _scene.timing.resources);
+}
+
 void SceneLoader::loadShaderConfig(const std::shared_ptr<Platform>& platform, Node shaders, Style& style,
                                    const std::shared_ptr<Scene>& scene) {
 
@@ -583,27 +629,54 @@ std::shared_ptr<Texture> SceneLoader::fetchTexture(const std::shared_ptr<Platfor
         if (!texture->loadImageFromMemory(textureData)) {
             LOGE("Invalid Base64 texture");
         }
+    } else if (url.scheme() == "zip") {
+        texture = std::make_shared<Texture>(std::vector<char>(), options, generateMipmaps);
+
+        // Decode textures of scene bundles straight from the archive data
+        scene->pendingTextures++;
+        resourceWorker().enqueue([platform, url, scene, texture]() {
+            auto error = scene->readZipEntry(url, [&](const char* data, size_t size) {
+                if (!texture->loadImageFromMemory(data, size)) {
+                    LOGE("Invalid texture data from URL '%s'", url.string().c_str());
+                }
+                if (texture->spriteAtlas()) {
+                    texture->spriteAtlas()->updateSpriteNodes({texture->getWidth(), texture->getHeight()});
+                }
+            });
+            if (error) {
+                LOGE("Error retrieving URL '%s': %s", url.string().c_str(), error);
+            }
+            scene->pendingTextures--;
+            if (scene->pendingTextures == 0) {
+                platform->requestRender();
+            }
+            scene->resourceLoaded();
+        });
     } else {
         texture = std::make_shared<Texture>(std::vector<char>(), options, generateMipmaps);
 
         scene->pendingTextures++;
-        scene->startUrlRequest(platform, url, [&, url, scene, texture](UrlResponse response) {
+        scene->startUrlRequest(platform, url, [platform, url, scene, texture](UrlResponse response) {
                 if (response.error) {
                     LOGE("Error retrieving URL '%s': %s", url.string().c_str(), response.error);
-                } else {
-                    if (texture) {
-                        if (!texture->loadImageFromMemory(std::move(response.content))) {
-                            LOGE("Invalid texture data from URL '%s'", url.string().c_str());
-                        }
-                        if (texture->spriteAtlas()) {
-                            texture->spriteAtlas()->updateSpriteNodes({texture->getWidth(), texture->getHeight()});
-                        }
-                    }
-                }
-                scene->pendingTextures--;
-                if (scene->pendingTextures == 0) {
-                    platform->requestRender();
+                    scene->pendingTextures--;
+                    scene->resourceLoaded();
+                    return;
                 }
+                resourceWorker().enqueue([platform, url, scene, texture,
+                                          content = std::move(response.content)]() {
+                    if (!texture->loadImageFromMemory(content)) {
+                        LOGE("Invalid texture data from URL '%s'", url.string().c_str());
+                    }
+                    if (texture->spriteAtlas()) {
+                        texture->spriteAtlas()->updateSpriteNodes({texture->getWidth(), texture->getHeight()});
+                    }
+                    scene->pendingTextures--;
+                    if (scene->pendingTextures == 0) {
+                        platform->requestRender();
+                    }
+                    scene->resourceLoaded();
+                });
             });
     }
 
@@ -730,10 +803,15 @@ void loadFontDescription(const std::shared_ptr<Platform>& platform, const Node&
     scene->startUrlRequest(platform, url, [_ft, scene](UrlResponse response) {
         if (response.error) {
             LOGE("Error retrieving font '%s' at %s: ", _ft.alias.c_str(), _ft.uri.c_str(), response.error);
-        } else {
-            scene->fontContext()->addFont(_ft, alfons::InputSource(std::move(response.content)));
+            scene->pendingFonts--;
+            scene->resourceLoaded();
+            return;
         }
-        scene->pendingFonts--;
+        resourceWorker().enqueue([_ft, scene, content = std::move(response.content)]() mutable {
+            scene->fontContext()->addFont(_ft, alfons::InputSource(std::move(content)));
+            scene->pendingFonts--;
+            scene->resourceLoaded();
+        });
     });
 }
 
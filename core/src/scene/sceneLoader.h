@@ -40,6 +40,10 @@ struct SceneLoader {
                           const std::vector<SceneUpdate>& updates = {});
 
     static bool applyConfig(const std::shared_ptr<Platform>& platform, const std::shared_ptr<Scene>& scene);
+
+    // Blocks until the textures and fonts requested by applyConfig() are loaded.
+    // Blocks on network requests: not to be called on the render thread.
+    static void waitForResources(Scene& scene);
     static bool applyUpdates(const std::shared_ptr<Platform>& platform, Scene& scene,
                              const std::vector<SceneUpdate>& updates);
     static void applyGlobals(Node root, Scene& scene);
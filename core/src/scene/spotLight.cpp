@@ -23,15 +23,18 @@ SpotLight::SpotLight(const std::string& _name, bool _dynamic) :
 SpotLight::~SpotLight() {}
 
 void SpotLight::setDirection(const glm::vec3 &_dir) {
+    m_version++;
     m_direction = _dir;
 }
 
 void SpotLight::setCutoffAngle(float _cutoffAngle) {
+    m_version++;
     m_spotCutoff = _cutoffAngle;
     m_spotCosCutoff = cos(_cutoffAngle * 3.14159 / 180.0);
 }
 
 void SpotLight::setCutoffExponent(float _exponent) {
+    m_version++;
     m_spotExponent = _exponent;
 }
 
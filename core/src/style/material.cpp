@@ -14,64 +14,74 @@ Material::Material() {
 }
 
 void Material::setEmission(glm::vec4 _emission){
+    m_version++;
     m_emission = _emission;
     m_emission_texture.tex.reset();
     setEmissionEnabled(true);
 }
 
 void Material::setEmission(MaterialTexture _emissionTexture){
+    m_version++;
     m_emission_texture = _emissionTexture;
     m_emission = glm::vec4(m_emission_texture.amount, 1.f);
     setEmissionEnabled((bool)m_emission_texture.tex);
 }
 
 void Material::setAmbient(glm::vec4 _ambient){
+    m_version++;
     m_ambient = _ambient;
     m_ambient_texture.tex.reset();
     setAmbientEnabled(true);
 }
 
 void Material::setAmbient(MaterialTexture _ambientTexture){
+    m_version++;
     m_ambient_texture = _ambientTexture;
     m_ambient = glm::vec4(m_ambient_texture.amount, 1.f);
     setAmbientEnabled((bool)m_ambient_texture.tex);
 }
 
 void Material::setDiffuse(glm::vec4 _diffuse){
+    m_version++;
     m_diffuse = _diffuse;
     m_diffuse_texture.tex.reset();
     setDiffuseEnabled(true);
 }
 
 void Material::setDiffuse(MaterialTexture _diffuseTexture){
+    m_version++;
     m_diffuse_texture = _diffuseTexture;
     m_diffuse = glm::vec4(m_diffuse_texture.amount, 1.f);
     setDiffuseEnabled((bool)m_diffuse_texture.tex);
 }
 
 void Material::setSpecular(glm::vec4 _specular){
+    m_version++;
     m_specular = _specular;
     m_specular_texture.tex.reset();
     setSpecularEnabled(true);
 }
 
 void Material::setSpecular(MaterialTexture _specularTexture){
+    m_version++;
     m_specular_texture = _specularTexture;
     m_specular = glm::vec4(m_specular_texture.amount, 1.f);
     setSpecularEnabled((bool)m_specular_texture.tex);
 }
 
 void Material::setShininess(float _shiny) {
+    m_version++;
     m_shininess = _shiny;
     setSpecularEnabled(true);
 }
 
-void Material::setEmissionEnabled(bool _enable) { m_bEmission = _enable; }
-void Material::setAmbientEnabled(bool _enable) { m_bAmbient = _enable; }
-void Material::setDiffuseEnabled(bool _enable) { m_bDiffuse = _enable; }
-void Material::setSpecularEnabled(bool _enable) { m_bSpecular = _enable; }
+void Material::setEmissionEnabled(bool _enable) { m_bEmission = _enable; m_version++; }
+void Material::setAmbientEnabled(bool _enable) { m_bAmbient = _enable; m_version++; }
+void Material::setDiffuseEnabled(bool _enable) { m_bDiffuse = _enable; m_version++; }
+void Material::setSpecularEnabled(bool _enable) { m_bSpecular = _enable; m_version++; }
 
 void Material::setNormal(MaterialTexture _normalTexture){
+    m_version++;
     m_normal_texture = _normalTexture;
     if (m_normal_texture.mapping == MappingType::spheremap){
         m_normal_texture.mapping = MappingType::planar;
@@ -114,6 +114,15 @@ public:
     bool hasDiffuse() const { return m_bDiffuse; }
     bool hasSpecular() const { return m_bSpecular; }
 
+    /* Material textures are bound to texture units for each frame */
+    bool hasTextures() const {
+        return m_emission_texture.tex || m_ambient_texture.tex || m_diffuse_texture.tex ||
+            m_specular_texture.tex || m_normal_texture.tex;
+    }
+
+    /* Incremented whenever a property of the material changes */
+    uint32_t version() const { return m_version; }
+
 private:
 
     /* Get defines that need to be injected on top of the shader */
@@ -141,6 +150,8 @@ private:
     MaterialTexture m_normal_texture;
 
     float m_shininess = .2f;
+
+    uint32_t m_version = 1;
 };
 
 }
@@ -1,10 +1,13 @@
 #include "style/pointStyle.h"
 
 #include "gl/dynamicQuadMesh.h"
+#include "gl/hardware.h"
+#include "gl/instancedQuadMesh.h"
 #include "gl/shaderProgram.h"
 #include "gl/texture.h"
 #include "gl/vertexLayout.h"
 #include "platform.h"
+#include "scene/scene.h"
 #include "scene/spriteAtlas.h"
 #include "style/pointStyleBuilder.h"
 #include "view/view.h"
@@ -25,14 +28,58 @@ PointStyle::PointStyle(std::string _name, std::shared_ptr<FontContext> _fontCont
 
 PointStyle::~PointStyle() {}
 
+static std::string instancedVertexSource(const ShaderProgram& _program) {
+    return "#define TANGRAM_POINT_INSTANCING\n" + _program.vertexShaderSource();
+}
+
 void PointStyle::build(const Scene& _scene) {
     Style::build(_scene);
 
+    // A previous scene keeps only the instanced variants of point programs,
+    // take them over in setupInstancing() instead of compiling new ones
+    m_reusableInstancedProgram = _scene.findReusableProgram(instancedVertexSource(*m_shaderProgram),
+                                                            m_shaderProgram->fragmentShaderSource());
+    if (m_selectionProgram) {
+        m_reusableInstancedSelectionProgram =
+            _scene.findReusableProgram(instancedVertexSource(*m_selectionProgram),
+                                       m_selectionProgram->fragmentShaderSource());
+    }
+
     m_textStyle->build(_scene);
 
     m_mesh = std::make_unique<DynamicQuadMesh<SpriteVertex>>(m_vertexLayout, m_drawMode);
 }
 
+void PointStyle::setupInstancing() {
+
+    m_instancingChecked = true;
+
+    auto reusableProgram = std::move(m_reusableInstancedProgram);
+    auto reusableSelectionProgram = std::move(m_reusableInstancedSelectionProgram);
+
+    if (!Hardware::supportsInstancedArrays) { return; }
+
+    // The instanced variant draws both, quads and instances, so that it can
+    // replace the program before its uniforms are set up
+    auto instancedVariant = [](const ShaderProgram& _program,
+                               std::shared_ptr<ShaderProgram> _reusable) {
+        if (_reusable) { return _reusable; }
+
+        auto program = std::make_shared<ShaderProgram>();
+        program->setDescription(_program.getDescription() + " instanced");
+        program->setShaderSource(instancedVertexSource(_program), _program.fragmentShaderSource());
+        return program;
+    };
+
+    m_shaderProgram = instancedVariant(*m_shaderProgram, std::move(reusableProgram));
+
+    if (m_selectionProgram) {
+        m_selectionProgram = instancedVariant(*m_selectionProgram, std::move(reusableSelectionProgram));
+    }
+
+    m_instancedMesh = std::make_unique<InstancedQuadMesh<SpriteInstance>>(m_instanceLayout, m_drawMode);
+}
+
 void PointStyle::constructVertexLayout() {
 
     m_vertexLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
@@ -44,6 +91,17 @@ void PointStyle::constructVertexLayout() {
         {"a_aa_factor", 1, GL_SHORT, true, 0},
         {"a_alpha", 1, GL_UNSIGNED_SHORT, true, 0},
     }));
+
+    m_instanceLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 2, GL_FLOAT, false, 0},
+        {"a_axes", 4, GL_FLOAT, false, 0},
+        {"a_uv_rect", 4, GL_SHORT, true, 0},
+        {"a_selection_color", 4, GL_UNSIGNED_BYTE, true, 0},
+        {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
+        {"a_outline_color", 4, GL_UNSIGNED_BYTE, true, 0},
+        {"a_aa_factor", 1, GL_SHORT, true, 0},
+        {"a_alpha", 1, GL_UNSIGNED_SHORT, true, 0},
+    }));
 }
 
 void PointStyle::constructShaderProgram() {
@@ -52,7 +110,11 @@ void PointStyle::constructShaderProgram() {
 }
 
 void PointStyle::onBeginUpdate() {
+    // Hardware capabilities are known once the map has set up GL
+    if (!m_instancingChecked) { setupInstancing(); }
+
     m_mesh->clear();
+    if (m_instancedMesh) { m_instancedMesh->clear(); }
     m_batches.clear();
     m_textStyle->onBeginUpdate();
 }
@@ -60,6 +122,7 @@ void PointStyle::onBeginUpdate() {
 void PointStyle::onBeginFrame(RenderState& rs) {
     // Upload meshes for next frame
     m_mesh->upload(rs);
+    if (m_instancedMesh) { m_instancedMesh->upload(rs); }
     m_textStyle->onBeginFrame(rs);
 }
 
@@ -75,6 +138,7 @@ void PointStyle::onBeginDrawFrame(RenderState& rs, const View& _view, Scene& _sc
 
 
     size_t vertexPos = 0;
+    size_t instancePos = 0;
     for (auto& batch : m_batches) {
 
         auto tex = batch.texture;
@@ -86,9 +150,17 @@ void PointStyle::onBeginDrawFrame(RenderState& rs, const View& _view, Scene& _sc
             tex->bind(rs, texUnit);
         }
 
-        m_mesh->drawRange(rs, *m_shaderProgram, vertexPos, batch.vertexCount);
-
-        vertexPos += batch.vertexCount;
+        if (batch.instanced) {
+            m_shaderProgram->setUniformi(rs, m_mainUniforms.uInstanced, 1);
+            m_instancedMesh->drawRange(rs, *m_shaderProgram, instancePos, batch.count);
+            instancePos += batch.count;
+        } else {
+            if (m_instancedMesh) {
+                m_shaderProgram->setUniformi(rs, m_mainUniforms.uInstanced, 0);
+            }
+            m_mesh->drawRange(rs, *m_shaderProgram, vertexPos, batch.count);
+            vertexPos += batch.count;
+        }
     }
 
     m_textStyle->onBeginDrawFrame(rs, _view, _scene);
@@ -104,8 +176,18 @@ void PointStyle::onBeginDrawSelectionFrame(RenderState& rs, const View& _view, S
     m_selectionProgram->setUniformMatrix4f(rs, m_selectionUniforms.uOrtho,
                                            _view.getOrthoViewportMatrix());
 
+    if (m_instancedMesh) {
+        m_selectionProgram->setUniformi(rs, m_selectionUniforms.uInstanced, 0);
+    }
     m_mesh->draw(rs, *m_selectionProgram, false);
 
+    if (m_instancedMesh && m_instancedMesh->numberOfInstances() > 0) {
+        m_instancedMesh->upload(rs);
+
+        m_selectionProgram->setUniformi(rs, m_selectionUniforms.uInstanced, 1);
+        m_instancedMesh->draw(rs, *m_selectionProgram, false);
+    }
+
     m_textStyle->onBeginDrawSelectionFrame(rs, _view, _scene);
 }
 
@@ -120,13 +202,28 @@ void PointStyle::setPixelScale(float _pixelScale) {
 
 SpriteVertex* PointStyle::pushQuad(Texture* texture) const {
 
-    if (m_batches.empty() || m_batches.back().texture != texture) {
-        m_batches.push_back({ texture });
+    if (m_batches.empty() || m_batches.back().texture != texture ||
+        m_batches.back().instanced) {
+        m_batches.push_back({ texture, false });
     }
 
-    m_batches.back().vertexCount += 4;
+    m_batches.back().count += 4;
 
     return m_mesh->pushQuad();
 }
 
+SpriteInstance* PointStyle::pushInstance(Texture* texture) const {
+
+    if (!m_instancedMesh) { return nullptr; }
+
+    if (m_batches.empty() || m_batches.back().texture != texture ||
+        !m_batches.back().instanced) {
+        m_batches.push_back({ texture, true });
+    }
+
+    m_batches.back().count += 1;
+
+    return m_instancedMesh->pushInstance();
+}
+
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "gl/dynamicQuadMesh.h"
+#include "gl/instancedQuadMesh.h"
 #include "labels/spriteLabel.h"
 #include "labels/labelProperty.h"
 #include "labels/textLabels.h"
@@ -42,7 +43,9 @@ public:
     const auto& defaultTexture() const { return m_defaultTexture; }
 
     auto& mesh() const { return m_mesh; }
-    virtual size_t dynamicMeshSize() const override { return m_mesh->bufferSize(); }
+    virtual size_t dynamicMeshSize() const override {
+        return m_mesh->bufferSize() + (m_instancedMesh ? m_instancedMesh->bufferSize() : 0);
+    }
 
     virtual std::unique_ptr<StyleBuilder> createBuilder() const override;
 
@@ -56,10 +59,18 @@ public:
 
     SpriteVertex* pushQuad(Texture* texture) const;
 
+    // Returns nullptr when instanced arrays are not available, the sprite
+    // is then added with pushQuad
+    SpriteInstance* pushInstance(Texture* texture) const;
+
 protected:
 
     void drawMesh(RenderState& rs, ShaderProgram& shaderProgram, UniformLocation& uSpriteMode);
 
+    // Switch to the instanced variants of the shader programs when the
+    // hardware supports it
+    void setupInstancing();
+
     std::shared_ptr<Texture> m_defaultTexture;
     const std::unordered_map<std::string, std::shared_ptr<Texture>>* m_textures = nullptr;
 
@@ -67,17 +78,29 @@ protected:
         UniformLocation uTex{"u_tex"};
         UniformLocation uOrtho{"u_ortho"};
         UniformLocation uSpriteMode{"u_sprite_mode"};
+        UniformLocation uInstanced{"u_instanced"};
     } m_mainUniforms, m_selectionUniforms;
 
     struct TextureBatch {
-        TextureBatch(Texture* t) : texture(t) {}
+        TextureBatch(Texture* t, bool i) : texture(t), instanced(i) {}
         Texture* texture = nullptr;
-        size_t vertexCount = 0;
+        bool instanced = false;
+        // Number of vertices in m_mesh or of instances in m_instancedMesh
+        size_t count = 0;
     };
 
+    std::shared_ptr<VertexLayout> m_instanceLayout;
+
     mutable std::unique_ptr<DynamicQuadMesh<SpriteVertex>> m_mesh;
+    mutable std::unique_ptr<InstancedQuadMesh<SpriteInstance>> m_instancedMesh;
     mutable std::vector<TextureBatch> m_batches;
 
+    bool m_instancingChecked = false;
+
+    // Instanced programs of the previous scene with the sources of this style
+    std::shared_ptr<ShaderProgram> m_reusableInstancedProgram;
+    std::shared_ptr<ShaderProgram> m_reusableInstancedSelectionProgram;
+
     std::unique_ptr<TextStyle> m_textStyle;
 };
 
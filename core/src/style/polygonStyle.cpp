@@ -141,9 +141,21 @@ std::unique_ptr<StyledMesh> PolygonStyleBuilder<V>::build() {
 
     auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(),
                                                       m_style.drawMode());
+
+    // Bounds including the extrusion height, for culling meshes outside of the view
+    glm::vec3 min(m_meshData.vertices[0].pos), max(min);
+    for (auto& vertex : m_meshData.vertices) {
+        min = glm::min(min, glm::vec3(vertex.pos));
+        max = glm::max(max, glm::vec3(vertex.pos));
+    }
+    mesh->setBounds(min / position_scale, max / position_scale);
+
     mesh->compile(m_meshData);
     m_meshData.clear();
 
+    // Most features are not interactive, so their selection colors are all zero
+    mesh->dropZeroAttrib("a_selection_color");
+
     return std::move(mesh);
 }
 
@@ -267,6 +267,10 @@ std::unique_ptr<StyledMesh> PolylineStyleBuilder<V>::build() {
 
     m_meshData[0].clear();
     m_meshData[1].clear();
+
+    // Most features are not interactive, so their selection colors are all zero
+    mesh->dropZeroAttrib("a_selection_color");
+
     return std::move(mesh);
 }
 
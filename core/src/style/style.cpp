@@ -13,10 +13,13 @@
 #include "scene/styleParam.h"
 #include "style/material.h"
 #include "tile/tile.h"
+#include "util/geom.h"
 #include "view/view.h"
 
 #include "rasters_glsl.h"
 
+#include <algorithm>
+
 namespace Tangram {
 
 Style::Style(std::string _name, Blending _blendMode, GLenum _drawMode, bool _selection) :
@@ -85,6 +88,7 @@ void Style::build(const Scene& _scene) {
         blocks.find("raster") != blocks.end()) {
         m_hasColorShaderBlock = true;
     }
+    m_hasPositionShaderBlock = blocks.find("position") != blocks.end();
 
     std::string vertSrc = m_shaderSource->buildVertexSource();
     std::string fragSrc = m_shaderSource->buildFragmentSource();
@@ -98,6 +102,9 @@ void Style::build(const Scene& _scene) {
             break;
         }
     }
+    if (!m_shaderProgram) {
+        m_shaderProgram = _scene.findReusableProgram(vertSrc, fragSrc);
+    }
     if (!m_shaderProgram) {
         m_shaderProgram = std::make_shared<ShaderProgram>();
         m_shaderProgram->setDescription("{style:" + m_name + "}");
@@ -119,6 +126,9 @@ void Style::build(const Scene& _scene) {
                 break;
             }
         }
+        if (!m_selectionProgram) {
+            m_selectionProgram = _scene.findReusableProgram(vertSrc, fragSrc);
+        }
         if (!m_selectionProgram) {
             m_selectionProgram = std::make_shared<ShaderProgram>();
             m_selectionProgram->setDescription("selection_program {style:" + m_name + "}");
@@ -130,6 +140,11 @@ void Style::build(const Scene& _scene) {
     m_shaderSource.reset();
 }
 
+void Style::swapSceneState(Style& _other) {
+    std::swap(m_mainUniforms.styleUniforms, _other.m_mainUniforms.styleUniforms);
+    std::swap(m_defaultDrawRule, _other.m_defaultDrawRule);
+}
+
 void Style::setLightingType(LightingType _type) {
     m_lightingType = _type;
 }
@@ -231,15 +246,47 @@ void Style::setupShaderUniforms(RenderState& rs, ShaderProgram& _program, const
 
     _program.setUniformf(rs, _uniforms.uDevicePixelRatio, m_pixelScale);
 
-    if (m_material.uniforms) {
-        m_material.material->setupProgram(rs, *m_shaderProgram, *m_material.uniforms);
+    // View, light and material uniforms are only evaluated again when their
+    // source changed, the program was relinked or another style sharing the
+    // program set its own values since they were last set.
+    bool programChanged = _program.generation() != _uniforms.programGeneration ||
+                          _program.uniformOwner() != this;
+    bool viewChanged = programChanged || _view.generation() != _uniforms.viewGeneration;
+
+    _uniforms.programGeneration = _program.generation();
+    _uniforms.viewGeneration = _view.generation();
+    _program.setUniformOwner(this);
+
+    // Materials and lights apply to the main program only
+    if (&_program == m_shaderProgram.get()) {
+
+        auto& material = m_material;
+        if (material.uniforms && (programChanged || material.material->hasTextures() ||
+                                  material.version != material.material->version())) {
+            material.material->setupProgram(rs, _program, *material.uniforms);
+            material.version = material.material->version();
+        }
+
+        // Set up lights, positions of lights depend on the view
+        for (auto& light : m_lights) {
+            if (viewChanged || light.version != light.light->version()) {
+                light.light->setupProgram(rs, _view, _program, *light.uniforms);
+                light.version = light.light->version();
+            }
+        }
     }
 
-    // Set up lights
-    for (const auto& light : m_lights) {
-        light.light->setupProgram(rs, _view, *m_shaderProgram, *light.uniforms);
+    if (viewChanged) {
+        setupViewUniforms(rs, _program, _view, _uniforms);
     }
 
+    setupSceneShaderUniforms(rs, _scene, _uniforms);
+
+}
+
+void Style::setupViewUniforms(RenderState& rs, ShaderProgram& _program, const View& _view,
+                              UniformBlock& _uniforms) {
+
     // Set Map Position
     _program.setUniformf(rs, _uniforms.uResolution, _view.getWidth(), _view.getHeight());
 
@@ -250,9 +297,6 @@ void Style::setupShaderUniforms(RenderState& rs, ShaderProgram& _program, const
     _program.setUniformf(rs, _uniforms.uMetersPerPixel, 1.0 / _view.pixelsPerMeter());
     _program.setUniformMatrix4f(rs, _uniforms.uView, _view.getViewMatrix());
     _program.setUniformMatrix4f(rs, _uniforms.uProj, _view.getProjectionMatrix());
-
-    setupSceneShaderUniforms(rs, _scene, _uniforms);
-
 }
 
 void Style::onBeginDrawFrame(RenderState& rs, const View& _view, Scene& _scene) {
@@ -352,7 +396,7 @@ void Style::drawSelectionFrame(RenderState& _rs, const Marker& _marker) {
 
     auto* mesh = _marker.mesh();
 
-    if (!mesh) { return; }
+    if (!mesh || !mesh->isSelectable()) { return; }
 
     m_selectionProgram->setUniformMatrix4f(_rs, m_selectionUniforms.uModel, _marker.modelMatrix());
     m_selectionProgram->setUniformf(_rs, m_selectionUniforms.uTileOrigin,
@@ -372,7 +416,7 @@ void Style::drawSelectionFrame(Tangram::RenderState& rs, const Tangram::Tile &_t
 
     auto& styleMesh = _tile.getMesh(*this);
 
-    if (!styleMesh) { return; }
+    if (!styleMesh || !styleMesh->isSelectable()) { return; }
 
     TileID tileID = _tile.getID();
 
@@ -408,11 +452,13 @@ void Style::draw(RenderState& rs, const View& _view, Scene& _scene,
 
     onBeginDrawFrame(rs, _view, _scene);
 
+    buildDrawQueue(_tiles);
+
     if (m_blend == Blending::translucent) {
         rs.colorMask(false, false, false, false);
     }
 
-    for (const auto& tile : _tiles) { draw(rs, *tile); }
+    for (const auto& command : m_drawQueue) { draw(rs, *command.tile); }
     for (const auto& marker : _markers) { draw(rs, *marker); }
 
     if (m_blend == Blending::translucent) {
@@ -424,7 +470,7 @@ void Style::draw(RenderState& rs, const View& _view, Scene& _scene,
         GL::stencilFunc(GL_EQUAL, GL_ZERO, 0xFF);
         GL::stencilOp(GL_KEEP, GL_KEEP, GL_INCR);
 
-        for (const auto& tile : _tiles) { draw(rs, *tile); }
+        for (const auto& command : m_drawQueue) { draw(rs, *command.tile); }
         for (const auto& marker : _markers) { draw(rs, *marker); }
 
         GL::disable(GL_STENCIL_TEST);
@@ -435,6 +481,66 @@ void Style::draw(RenderState& rs, const View& _view, Scene& _scene,
 }
 
 
+uint64_t Style::drawKey(const Tile& _tile) const {
+
+    // Proxy tiles last, so that they are drawn behind the tiles they stand
+    // in for and u_proxy_depth changes only once
+    uint64_t key = _tile.isProxy() ? (1ull << 63) : 0;
+
+    // Group tiles sampling the same raster, e.g. children of one lower zoom raster tile.
+    // Keyed on the raster tile coordinates, so that the order does not change between runs.
+    if (hasRasters()) {
+        for (auto& raster : _tile.rasters()) {
+            if (raster.isValid()) {
+                const auto& id = raster.tileID;
+                key |= (uint64_t(id.z & 0x3f) << 56) |
+                       (uint64_t(id.x & 0xfffffff) << 28) |
+                       uint64_t(id.y & 0xfffffff);
+                break;
+            }
+        }
+    }
+    return key;
+}
+
+Style::CullStats& Style::cullStats() {
+    thread_local CullStats stats;
+    return stats;
+}
+
+bool Style::isCulled(const Tile& _tile, const StyledMesh& _mesh) const {
+
+    if (!_mesh.hasBounds() || m_hasPositionShaderBlock) { return false; }
+
+    return isBoxOutsideClipSpace(_tile.mvp(), _mesh.boundsMin(), _mesh.boundsMax());
+}
+
+void Style::buildDrawQueue(const std::vector<std::shared_ptr<Tile>>& _tiles) {
+
+    m_drawQueue.clear();
+
+    auto& stats = cullStats();
+
+    for (const auto& tile : _tiles) {
+        auto& mesh = tile->getMesh(*this);
+        if (!mesh) { continue; }
+
+        if (isCulled(*tile, *mesh)) {
+            stats.culled++;
+            continue;
+        }
+        stats.drawn++;
+
+        m_drawQueue.push_back({ drawKey(*tile), tile.get() });
+    }
+
+    // Without depth test the result depends on the drawing order
+    if (m_blend == Blending::overlay || m_blend == Blending::inlay) { return; }
+
+    std::stable_sort(m_drawQueue.begin(), m_drawQueue.end(),
+                     [](const auto& a, const auto& b) { return a.key < b.key; });
+}
+
 void Style::draw(RenderState& rs, const Tile& _tile) {
 
     auto& styleMesh = _tile.getMesh(*this);
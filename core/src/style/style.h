@@ -57,7 +57,27 @@ struct StyledMesh {
     virtual bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true) = 0;
     virtual size_t bufferSize() const = 0;
 
+    // False when the mesh has no selection colors to draw in the selection pass
+    virtual bool isSelectable() const { return true; }
+
     virtual ~StyledMesh() {}
+
+    // Bounds of the vertex positions in tile units, set by builders that know
+    // the position format of their vertices. Meshes without bounds are always drawn.
+    void setBounds(const glm::vec3& _min, const glm::vec3& _max) {
+        m_boundsMin = _min;
+        m_boundsMax = _max;
+        m_hasBounds = true;
+    }
+
+    bool hasBounds() const { return m_hasBounds; }
+    const glm::vec3& boundsMin() const { return m_boundsMin; }
+    const glm::vec3& boundsMax() const { return m_boundsMax; }
+
+private:
+    glm::vec3 m_boundsMin;
+    glm::vec3 m_boundsMax;
+    bool m_hasBounds = false;
 };
 
 class StyleBuilder {
@@ -145,6 +165,9 @@ protected:
 
     bool m_hasColorShaderBlock = false;
 
+    /* Position blocks can move vertices outside of the mesh bounds */
+    bool m_hasPositionShaderBlock = false;
+
     RasterType m_rasterType = RasterType::none;
 
     bool m_selection;
@@ -171,6 +194,10 @@ private:
         UniformLocation uRasterOffsets{"u_raster_offsets"};
 
         std::vector<StyleUniform> styleUniforms;
+
+        // Program and view generations of the last applied view uniforms
+        uint32_t programGeneration = 0;
+        uint32_t viewGeneration = 0;
     } m_mainUniforms, m_selectionUniforms;
 
     /* Set uniform values when @_updateUniforms is true,
@@ -180,10 +207,15 @@ private:
     void setupShaderUniforms(RenderState& rs, ShaderProgram& _program, const View& _view,
                              Scene& _scene, UniformBlock& _uniformBlock);
 
+    void setupViewUniforms(RenderState& rs, ShaderProgram& _program, const View& _view,
+                           UniformBlock& _uniformBlock);
+
     struct LightHandle {
         LightHandle(Light* _light, std::unique_ptr<LightUniforms> _uniforms);
         Light *light;
         std::unique_ptr<LightUniforms> uniforms;
+        // Light version of the last applied uniforms
+        uint32_t version = 0;
     };
 
 
@@ -191,13 +223,41 @@ private:
         /* <Material> used for drawing meshes that use this style */
         std::shared_ptr<Material> material;
         std::unique_ptr<MaterialUniforms> uniforms;
+        // Material version of the last applied uniforms
+        uint32_t version = 0;
     };
 
     std::vector<LightHandle> m_lights;
     MaterialHandle m_material;
 
+    struct DrawCommand {
+        // Packed render state of the tile, see drawKey()
+        uint64_t key;
+        const Tile* tile;
+    };
+
+    /* Tiles to draw in the current frame, ordered to minimize state changes */
+    std::vector<DrawCommand> m_drawQueue;
+
+    /* Sort key grouping tiles that share uniform values and textures */
+    uint64_t drawKey(const Tile& _tile) const;
+
+    void buildDrawQueue(const std::vector<std::shared_ptr<Tile>>& _tiles);
+
+    /* Whether the bounds of the tile mesh are outside of the view */
+    bool isCulled(const Tile& _tile, const StyledMesh& _mesh) const;
+
 public:
 
+    struct CullStats {
+        // Tile meshes drawn and skipped because they are outside of the view
+        uint32_t drawn = 0;
+        uint32_t culled = 0;
+    };
+
+    /* Counts of all styles for the current frame of the calling thread, reset by Map::render */
+    static CullStats& cullStats();
+
     Style(std::string _name, Blending _blendMode, GLenum _drawMode, bool _selection);
 
     virtual ~Style();
@@ -293,6 +353,9 @@ public:
 
     ShaderSource& getShaderSource() const { return *m_shaderSource; }
 
+    const auto& shaderProgram() const { return m_shaderProgram; }
+    const auto& selectionProgram() const { return m_selectionProgram; }
+
     const std::string& getName() const { return m_name; }
     const uint32_t& getID() const { return m_id; }
 
@@ -304,6 +367,12 @@ public:
 
     std::vector<StyleUniform>& styleUniforms() { return m_mainUniforms.styleUniforms; }
 
+    /* Swap uniform values and default draw rule, which refer to the scene that
+     * a style was loaded for, with _other: a style loaded from the same config,
+     * apart from uniform values, for another scene. Tile workers must not be
+     * building with either style, see TileWorker::runWhileIdle() */
+    void swapSceneState(Style& _other);
+
     void setDefaultDrawRule(std::unique_ptr<DrawRuleData>&& _rule);
     void applyDefaultDrawRules(DrawRule& _rule) const;
 
@@ -79,7 +79,7 @@ void TextStyle::onBeginDrawFrame(RenderState& rs, const View& _view, Scene& _sce
     m_shaderProgram->setUniformf(rs, m_mainUniforms.uMaxStrokeWidth,
                                  m_context->maxStrokeWidth());
     m_shaderProgram->setUniformf(rs, m_mainUniforms.uTexScaleFactor,
-                                 glm::vec2(1.0f / GlyphTexture::size));
+                                 glm::vec2(1.0f / m_context->glyphTextureSize()));
     m_shaderProgram->setUniformi(rs, m_mainUniforms.uTex, texUnit);
     m_shaderProgram->setUniformMatrix4f(rs, m_mainUniforms.uOrtho,
                                         _view.getOrthoViewportMatrix());
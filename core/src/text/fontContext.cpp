@@ -6,6 +6,7 @@
 #define SDF_IMPLEMENTATION
 #include "sdf.h"
 
+#include <algorithm>
 #include <memory>
 #include <regex>
 
@@ -17,11 +18,38 @@ namespace Tangram {
 
 const std::vector<float> FontContext::s_fontRasterSizes = { 16, 28, 40 };
 
-FontContext::FontContext(std::shared_ptr<const Platform> _platform) :
+static std::mutex s_optionsMutex;
+static FontContext::Options s_defaultOptions;
+
+void FontContext::setDefaultOptions(Options _options) {
+    std::lock_guard<std::mutex> lock(s_optionsMutex);
+    s_defaultOptions = _options;
+}
+
+FontContext::Options FontContext::defaultOptions() {
+    std::lock_guard<std::mutex> lock(s_optionsMutex);
+    return s_defaultOptions;
+}
+
+FontContext::FontContext(std::shared_ptr<const Platform> _platform, Options _options) :
+    m_options(_options),
     m_sdfRadius(SDF_WIDTH),
-    m_atlas(*this, GlyphTexture::size, m_sdfRadius),
+    m_atlas(*this, m_options.atlasSize, m_sdfRadius),
     m_batch(m_atlas, m_scratch),
-    m_platform(_platform) {}
+    m_platform(_platform) {
+
+    if (!m_options.glyphCachePath.empty()) {
+        m_glyphCache = GlyphCache::open(m_options.glyphCachePath);
+    }
+}
+
+FontContext::~FontContext() {
+    if (m_glyphCache) { m_glyphCache->save(); }
+
+    auto stats = m_shapingCache.stats();
+    LOGD("Shaping cache: %d hits, %d misses, hit rate %.2f", int(stats.hits), int(stats.misses),
+         stats.hitRate());
+}
 
 void FontContext::setPixelScale(float _scale) {
     m_sdfRadius = SDF_WIDTH * _scale;
@@ -61,7 +89,7 @@ void FontContext::loadFonts() {
     }
 }
 
-// Synchronized on m_mutex in layoutText(), called on tile-worker threads
+// Synchronized on m_textureMutex, called from layoutText() on tile-worker threads
 void FontContext::addTexture(alfons::AtlasID id, uint16_t width, uint16_t height) {
 
     std::lock_guard<std::mutex> lock(m_textureMutex);
@@ -70,10 +98,10 @@ void FontContext::addTexture(alfons::AtlasID id, uint16_t width, uint16_t height
         LOGE("Way too many glyph textures!");
         return;
     }
-    m_textures.emplace_back();
+    m_textures.emplace_back(m_options.atlasSize);
 }
 
-// Synchronized on m_mutex in layoutText(), called on tile-worker threads
+// Synchronized on m_textureMutex, called from layoutText() on tile-worker threads
 void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_t gw, uint16_t gh,
                            const unsigned char* src, uint16_t pad) {
 
@@ -84,8 +112,13 @@ void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_
     auto& texData = m_textures[id].texData;
     auto& texture = m_textures[id].texture;
 
-    size_t stride = GlyphTexture::size;
-    size_t width =  GlyphTexture::size;
+    size_t stride = m_options.atlasSize;
+    size_t width =  m_options.atlasSize;
+
+    uint64_t cacheKey = 0;
+    if (m_glyphCache) {
+        cacheKey = GlyphCache::key(src, gw, gh, pad, m_sdfRadius);
+    }
 
     unsigned char* dst = &texData[(gx + pad) + (gy + pad) * stride];
 
@@ -97,24 +130,32 @@ void FontContext::addGlyph(alfons::AtlasID id, uint16_t gx, uint16_t gy, uint16_
     gw += pad * 2;
     gh += pad * 2;
 
-    size_t bytes = size_t(gw) * size_t(gh) * sizeof(float) * 3;
-    if (m_sdfBuffer.size() < bytes) {
-        m_sdfBuffer.resize(bytes);
-    }
+    if (!m_glyphCache || !m_glyphCache->get(cacheKey, gw, gh, dst, width)) {
+
+        size_t bytes = size_t(gw) * size_t(gh) * sizeof(float) * 3;
+        if (m_sdfBuffer.size() < bytes) {
+            m_sdfBuffer.resize(bytes);
+        }
 
-    sdfBuildDistanceFieldNoAlloc(dst, width, m_sdfRadius,
-                                 dst, gw, gh, width,
-                                 &m_sdfBuffer[0]);
+        sdfBuildDistanceFieldNoAlloc(dst, width, m_sdfRadius,
+                                     dst, gw, gh, width,
+                                     &m_sdfBuffer[0]);
 
-    texture.setDirty(gy, gh);
+        if (m_glyphCache) {
+            m_glyphCache->put(cacheKey, gw, gh, dst, width);
+        }
+    }
+
+    texture.setDirtyRect(gx, gy, gw, gh);
     m_textures[id].dirty = true;
+    m_textures[id].empty = false;
 }
 
 void FontContext::releaseAtlas(std::bitset<max_textures> _refs) {
     if (!_refs.any()) { return; }
     std::lock_guard<std::mutex> lock(m_textureMutex);
     for (size_t i = 0; i < m_textures.size(); i++) {
-        if (_refs[i]) { m_atlasRefCount[i] -= 1; }
+        if (_refs[i] && --m_atlasRefCount[i] == 0) { m_atlasChanges++; }
     }
 }
 
@@ -126,10 +167,43 @@ void FontContext::updateTextures(RenderState& rs) {
             gt.dirty = false;
             auto td = reinterpret_cast<const GLuint*>(gt.texData.data());
             gt.texture.update(rs, 0, td);
+            m_atlasChanges++;
         }
     }
 }
 
+void FontContext::releaseUnusedAtlases() {
+    // Nothing more can be released until an atlas was uploaded or lost its last label
+    uint32_t changes = m_atlasChanges;
+    if (changes == m_releasedAtlasChanges) { return; }
+
+    std::lock_guard<std::mutex> fontLock(m_fontMutex);
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+
+    m_releasedAtlasChanges = changes;
+
+    for (size_t i = 0; i < m_textures.size(); i++) {
+        if (m_atlasRefCount[i] != 0) { continue; }
+
+        if (!m_textures[i].empty) {
+            m_atlas.clear(i);
+            m_textures[i].texData.assign(m_options.atlasSize *
+                                         m_options.atlasSize, 0);
+            m_textures[i].empty = true;
+            m_shapingCache.invalidateAtlas(i);
+        }
+        m_textures[i].dirty = false;
+        m_textures[i].texture.releaseGPUMemory();
+    }
+}
+
+size_t FontContext::glyphAtlasCount() {
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+
+    return std::count_if(m_textures.begin(), m_textures.end(),
+                         [](const auto& gt) { return !gt.empty; });
+}
+
 void FontContext::bindTexture(RenderState& rs, alfons::AtlasID _id, GLuint _unit) {
     std::lock_guard<std::mutex> lock(m_textureMutex);
     m_textures[_id].texture.bind(rs, _unit);
@@ -140,7 +214,52 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
                              std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
                              glm::vec2& _size, TextRange& _textRanges) {
 
-    std::lock_guard<std::mutex> lock(m_fontMutex);
+    std::array<bool, 3> alignments = {};
+    if (_params.align != TextLabelProperty::Align::none) {
+        alignments[int(_params.align)] = true;
+    }
+
+    // Collect possible alignment from anchor fallbacks
+    for (int i = 0; i < _params.labelOptions.anchors.count; i++) {
+        auto anchor = _params.labelOptions.anchors[i];
+        TextLabelProperty::Align alignment = TextLabelProperty::alignFromAnchor(anchor);
+        if (alignment != TextLabelProperty::Align::none) {
+            alignments[int(alignment)] = true;
+        }
+    }
+
+    ShapingCache::Key cacheKey { _text, _params.font.get(), _params.fontScale, _params.lineSpacing,
+                                 _params.wordWrap ? _params.maxLineWidth : 0,
+                                 _params.wordWrap ? _params.maxLines : 0,
+                                 _params.wordWrap,
+                                 uint8_t(alignments[0] | alignments[1] << 1 | alignments[2] << 2) };
+
+    {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+
+        if (auto* entry = m_shapingCache.get(cacheKey)) {
+            int quadsStart = _quads.size();
+            _quads.insert(_quads.end(), entry->quads.begin(), entry->quads.end());
+
+            for (size_t i = 0; i < _textRanges.size(); i++) {
+                _textRanges[i] = Range(entry->textRanges[i].start + quadsStart,
+                                       entry->textRanges[i].length);
+            }
+            _size = entry->size;
+
+            for (size_t i = 0; i < m_textures.size(); i++) {
+                if (entry->atlases[i] && !_refs[i]) {
+                    _refs[i] = true;
+                    m_atlasRefCount[i]++;
+                }
+            }
+            return true;
+        }
+    }
+
+    // Guards the shaper and glyph atlas. Released once the glyphs of this text
+    // are referenced, so that they cannot be cleared from their atlas.
+    std::unique_lock<std::mutex> fontLock(m_fontMutex);
 
     alfons::LineLayout line = m_shaper.shapeICU(_params.font, _text, MIN_LINE_WIDTH,
                                                 _params.wordWrap ? _params.maxLineWidth : 0);
@@ -160,20 +279,6 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
     size_t quadsStart = _quads.size();
     alfons::LineMetrics metrics;
 
-    std::array<bool, 3> alignments = {};
-    if (_params.align != TextLabelProperty::Align::none) {
-        alignments[int(_params.align)] = true;
-    }
-
-    // Collect possible alignment from anchor fallbacks
-    for (int i = 0; i < _params.labelOptions.anchors.count; i++) {
-        auto anchor = _params.labelOptions.anchors[i];
-        TextLabelProperty::Align alignment = TextLabelProperty::alignFromAnchor(anchor);
-        if (alignment != TextLabelProperty::Align::none) {
-            alignments[int(alignment)] = true;
-        }
-    }
-
     if (_params.wordWrap) {
         m_textWrapper.clearWraps();
 
@@ -232,46 +337,66 @@ bool FontContext::layoutText(TextStyle::Parameters& _params, const icu::UnicodeS
         _textRanges[2] = Range(rangeEnd, 0);
     }
 
-    auto it = _quads.begin() + quadsStart;
-    if (it == _quads.end()) {
+    if (_quads.size() == quadsStart) {
         // No glyphs added
         return false;
     }
 
-    // TextLabel parameter: Dimension
-    float width = metrics.aabb.z - metrics.aabb.x;
-    float height = metrics.aabb.w - metrics.aabb.y;
-    _size = glm::vec2(width, height);
-
-    // Offset to center all glyphs around 0/0
-    glm::vec2 offset((metrics.aabb.x + width * 0.5) * TextVertex::position_scale,
-                     (metrics.aabb.y + height * 0.5) * TextVertex::position_scale);
+    ShapingCache::Entry entry;
 
     {
         std::lock_guard<std::mutex> lock(m_textureMutex);
-        for (; it != _quads.end(); ++it) {
 
+        for (auto it = _quads.begin() + quadsStart; it != _quads.end(); ++it) {
             if (!_refs[it->atlas]) {
                 _refs[it->atlas] = true;
                 m_atlasRefCount[it->atlas]++;
             }
-
-            it->quad[0].pos -= offset;
-            it->quad[1].pos -= offset;
-            it->quad[2].pos -= offset;
-            it->quad[3].pos -= offset;
+            entry.atlases[it->atlas] = true;
         }
 
         // Clear unused textures
         for (size_t i = 0; i < m_textures.size(); i++) {
-            if (m_atlasRefCount[i] == 0) {
+            if (m_atlasRefCount[i] == 0 && !m_textures[i].empty) {
                 m_atlas.clear(i);
-                m_textures[i].texData.assign(GlyphTexture::size *
-                                             GlyphTexture::size, 0);
+                m_textures[i].texData.assign(m_options.atlasSize *
+                                             m_options.atlasSize, 0);
+                m_textures[i].empty = true;
+                m_shapingCache.invalidateAtlas(i);
             }
         }
     }
 
+    fontLock.unlock();
+
+    // TextLabel parameter: Dimension
+    float width = metrics.aabb.z - metrics.aabb.x;
+    float height = metrics.aabb.w - metrics.aabb.y;
+    _size = glm::vec2(width, height);
+
+    // Offset to center all glyphs around 0/0
+    glm::vec2 offset((metrics.aabb.x + width * 0.5) * TextVertex::position_scale,
+                     (metrics.aabb.y + height * 0.5) * TextVertex::position_scale);
+
+    for (auto it = _quads.begin() + quadsStart; it != _quads.end(); ++it) {
+        it->quad[0].pos -= offset;
+        it->quad[1].pos -= offset;
+        it->quad[2].pos -= offset;
+        it->quad[3].pos -= offset;
+    }
+
+    entry.quads.assign(_quads.begin() + quadsStart, _quads.end());
+    for (size_t i = 0; i < _textRanges.size(); i++) {
+        entry.textRanges[i] = Range(_textRanges[i].start - int(quadsStart), _textRanges[i].length);
+    }
+    entry.size = _size;
+
+    {
+        // The referenced atlases cannot be cleared until the caller releases them
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        m_shapingCache.put(std::move(cacheKey), std::move(entry));
+    }
+
     return true;
 }
 
@@ -287,6 +412,10 @@ void FontContext::addFont(const FontDescription& _ft, alfons::InputSource _sourc
         // add fallbacks from default font
         font->addFaces(*m_font[i]);
     }
+
+    // Texts may have been laid out with fallback faces before
+    std::lock_guard<std::mutex> lock(m_textureMutex);
+    m_shapingCache.clear();
 }
 
 void FontContext::releaseFonts() {
@@ -3,6 +3,8 @@
 #include "gl/texture.h"
 #include "labels/textLabel.h"
 #include "style/textStyle.h"
+#include "text/glyphCache.h"
+#include "text/shapingCache.h"
 #include "text/textUtil.h"
 
 #include "alfons/alfons.h"
@@ -12,6 +14,7 @@
 #include "alfons/inputSource.h"
 #include "alfons/textBatch.h"
 #include "alfons/textShaper.h"
+#include <atomic>
 #include <bitset>
 #include <mutex>
 
@@ -24,16 +27,20 @@ struct FontMetrics {
 // TODO could be a shared_ptr<Texture>
 struct GlyphTexture {
 
-    static constexpr int size = 256;
+    static constexpr int default_size = 512;
 
-    GlyphTexture() : texture(size, size) {
+    GlyphTexture(int _size) : size(_size), texture(_size, _size) {
         texData.resize(size * size);
+        texture.setMemoryCategory(GPUMemory::glyphs);
     }
 
+    int size;
     std::vector<unsigned char> texData;
     Texture texture;
 
     bool dirty = false;
+    // No glyphs were added since the atlas was cleared
+    bool empty = true;
     size_t refCount = 0;
 };
 
@@ -63,17 +70,30 @@ public:
 
     static constexpr int max_textures = 64;
 
-    FontContext(std::shared_ptr<const Platform> _platform);
+    struct Options {
+        // Width and height of the glyph atlas textures
+        int atlasSize = GlyphTexture::default_size;
+        // File to keep glyph distance fields between sessions, disabled when empty
+        std::string glyphCachePath;
+    };
+
+    // Options used for FontContexts created after this call
+    static void setDefaultOptions(Options _options);
+    static Options defaultOptions();
+
+    FontContext(std::shared_ptr<const Platform> _platform, Options _options = defaultOptions());
+
+    ~FontContext();
 
     void loadFonts();
 
-    /* Synchronized on m_mutex on tile-worker threads
+    /* Synchronized on m_textureMutex, called on tile-worker threads
      * Called from alfons when a texture atlas needs to be created
      * Triggered from TextStyleBuilder::prepareLabel
      */
     void addTexture(alfons::AtlasID id, uint16_t width, uint16_t height) override;
 
-    /* Synchronized on m_mutex, called tile-worker threads
+    /* Synchronized on m_textureMutex, called on tile-worker threads
      * Called from alfons when a glyph needs to be added the the atlas identified by id
      * Triggered from TextStyleBuilder::prepareLabel
      */
@@ -85,6 +105,14 @@ public:
     /* Update all textures batches, uploads the data to the GPU */
     void updateTextures(RenderState& rs);
 
+    /* Clear atlases that no label refers to and delete their GL textures.
+     * Returns immediately when no atlas changed since the last call.
+     */
+    void releaseUnusedAtlases();
+
+    /* Returns the number of glyph atlas textures that hold glyphs */
+    size_t glyphAtlasCount();
+
     std::shared_ptr<alfons::Font> getFont(const std::string& _family, const std::string& _style,
                                           const std::string& _weight, float _size);
 
@@ -95,12 +123,25 @@ public:
 
     void bindTexture(RenderState& rs, alfons::AtlasID _id, GLuint _unit);
 
+    int glyphTextureSize() const { return m_options.atlasSize; }
+
     float maxStrokeWidth() { return m_sdfRadius; }
 
+    /* Lays out _text and appends its glyph quads to _quads.
+     * Layouts of repeated texts are taken from the shaping cache without
+     * running the text shaper again. Otherwise shaping and adding glyphs to
+     * the atlas hold m_fontMutex: the shaper and the FreeType faces of the
+     * fonts are shared by all tile-workers.
+     */
     bool layoutText(TextStyle::Parameters& _params, const icu::UnicodeString& _text,
                     std::vector<GlyphQuad>& _quads, std::bitset<max_textures>& _refs,
                     glm::vec2& _bbox, TextRange& _textRanges);
 
+    ShapingCache::Stats shapingCacheStats() {
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        return m_shapingCache.stats();
+    }
+
     struct ScratchBuffer : public alfons::MeshCallback {
         void drawGlyph(const alfons::Quad& q, const alfons::AtlasGlyph& altasGlyph) override {}
         void drawGlyph(const alfons::Rect& q, const alfons::AtlasGlyph& atlasGlyph) override;
@@ -117,6 +158,8 @@ private:
 
     static const std::vector<float> s_fontRasterSizes;
 
+    Options m_options;
+
     float m_sdfRadius;
     ScratchBuffer m_scratch;
     std::vector<unsigned char> m_sdfBuffer;
@@ -125,6 +168,11 @@ private:
     std::mutex m_textureMutex;
 
     std::array<int, max_textures> m_atlasRefCount = {{0}};
+
+    // Counts atlas uploads and atlases losing their last reference
+    std::atomic<uint32_t> m_atlasChanges{0};
+    // Value of m_atlasChanges at the last releaseUnusedAtlases(), render thread only
+    uint32_t m_releasedAtlasChanges = 0;
     alfons::GlyphAtlas m_atlas;
 
     alfons::FontManager m_alfons;
@@ -132,6 +180,12 @@ private:
 
     std::vector<GlyphTexture> m_textures;
 
+    // Shared with the other FontContexts using the same file
+    std::shared_ptr<GlyphCache> m_glyphCache;
+
+    // Synchronized on m_textureMutex, since entries depend on the atlas contents
+    ShapingCache m_shapingCache;
+
     // TextShaper to create <LineLayout> for a given text and Font
     alfons::TextShaper m_shaper;
 
@@ -0,0 +1,222 @@
+#include "text/glyphCache.h"
+
+#include "log.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+
+namespace Tangram {
+
+static const char cache_magic[4] = { 'T', 'G', 'G', 'C' };
+static const uint32_t cache_version = 1;
+
+constexpr size_t GlyphCache::max_entries;
+
+// Caches shared by the FontContexts of this process, by path
+static std::mutex s_cachesMutex;
+static std::unordered_map<std::string, std::weak_ptr<GlyphCache>> s_caches;
+
+// 64 bit FNV-1a, stable across platforms and runs
+static void fnv1a(uint64_t& _hash, const void* _data, size_t _length) {
+    auto* bytes = static_cast<const unsigned char*>(_data);
+    for (size_t i = 0; i < _length; i++) {
+        _hash ^= bytes[i];
+        _hash *= 1099511628211ull;
+    }
+}
+
+uint64_t GlyphCache::key(const unsigned char* _bitmap, uint16_t _width, uint16_t _height,
+                         uint16_t _pad, float _sdfRadius) {
+
+    uint64_t hash = 14695981039346656037ull;
+
+    fnv1a(hash, &_width, sizeof(_width));
+    fnv1a(hash, &_height, sizeof(_height));
+    fnv1a(hash, &_pad, sizeof(_pad));
+    fnv1a(hash, &_sdfRadius, sizeof(_sdfRadius));
+    fnv1a(hash, _bitmap, size_t(_width) * _height);
+
+    return hash;
+}
+
+std::shared_ptr<GlyphCache> GlyphCache::open(const std::string& _path) {
+
+    std::lock_guard<std::mutex> lock(s_cachesMutex);
+
+    auto& entry = s_caches[_path];
+    if (auto cache = entry.lock()) { return cache; }
+
+    auto cache = std::make_shared<GlyphCache>();
+    cache->m_path = _path;
+    cache->m_loading = true;
+
+    // Loading stays off the scene-load path, the destructor joins the thread
+    GlyphCache* loading = cache.get();
+    cache->m_loader = std::thread([loading, _path]() {
+        loading->load(_path);
+        {
+            std::lock_guard<std::mutex> lock(loading->m_mutex);
+            loading->m_loading = false;
+        }
+        loading->m_loadedCondition.notify_all();
+    });
+
+    entry = cache;
+    return cache;
+}
+
+GlyphCache::~GlyphCache() {
+    if (m_loader.joinable()) { m_loader.join(); }
+}
+
+bool GlyphCache::load(const std::string& _path) {
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_path = _path;
+    }
+
+    std::ifstream file(_path, std::ifstream::binary);
+    if (!file.is_open()) { return false; }
+
+    char magic[4];
+    uint32_t version = 0, count = 0;
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+    if (!file || std::memcmp(magic, cache_magic, sizeof(magic)) != 0 ||
+        version != cache_version || count > max_entries) {
+        LOGW("Ignoring invalid glyph cache: %s", _path.c_str());
+        return false;
+    }
+
+    std::unordered_map<uint64_t, Entry> entries;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t key;
+        Entry entry;
+
+        file.read(reinterpret_cast<char*>(&key), sizeof(key));
+        file.read(reinterpret_cast<char*>(&entry.width), sizeof(entry.width));
+        file.read(reinterpret_cast<char*>(&entry.height), sizeof(entry.height));
+        if (file) {
+            entry.data.resize(size_t(entry.width) * entry.height);
+            file.read(reinterpret_cast<char*>(entry.data.data()), entry.data.size());
+        }
+        if (!file) {
+            LOGW("Ignoring truncated glyph cache: %s", _path.c_str());
+            return false;
+        }
+
+        entries.emplace(key, std::move(entry));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Glyphs put meanwhile were rasterized with the current settings, keep them
+    for (auto& it : entries) {
+        if (m_entries.size() >= max_entries) { break; }
+        m_entries.emplace(it.first, std::move(it.second));
+    }
+
+    LOGD("Loaded %d glyphs from cache %s", int(entries.size()), _path.c_str());
+
+    return true;
+}
+
+bool GlyphCache::save() {
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_loadedCondition.wait(lock, [&]() { return !m_loading; });
+
+    if (m_path.empty() || !m_modified) { return true; }
+
+    // Write to a temporary file of this process first, so that a concurrent
+    // reader never sees a partially written cache and other processes saving
+    // the same cache do not write into it
+    std::string tmpPath = m_path + ".tmp" + std::to_string(getpid());
+
+    {
+        std::ofstream file(tmpPath, std::ofstream::binary | std::ofstream::trunc);
+        if (!file.is_open()) {
+            LOGW("Cannot write glyph cache: %s", tmpPath.c_str());
+            return false;
+        }
+
+        uint32_t count = m_entries.size();
+
+        file.write(cache_magic, sizeof(cache_magic));
+        file.write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+        for (auto& it : m_entries) {
+            auto& entry = it.second;
+            file.write(reinterpret_cast<const char*>(&it.first), sizeof(it.first));
+            file.write(reinterpret_cast<const char*>(&entry.width), sizeof(entry.width));
+            file.write(reinterpret_cast<const char*>(&entry.height), sizeof(entry.height));
+            file.write(reinterpret_cast<const char*>(entry.data.data()), entry.data.size());
+        }
+
+        if (!file) {
+            LOGW("Failed writing glyph cache: %s", tmpPath.c_str());
+            file.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), m_path.c_str()) != 0) {
+        LOGW("Failed replacing glyph cache: %s", m_path.c_str());
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    m_modified = false;
+    return true;
+}
+
+size_t GlyphCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+bool GlyphCache::get(uint64_t _key, uint16_t _width, uint16_t _height,
+                     unsigned char* _dst, size_t _stride) const {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(_key);
+    if (it == m_entries.end()) { return false; }
+
+    auto& entry = it->second;
+    if (entry.width != _width || entry.height != _height) { return false; }
+
+    for (size_t y = 0; y < _height; y++) {
+        std::memcpy(_dst + y * _stride, &entry.data[y * _width], _width);
+    }
+    return true;
+}
+
+void GlyphCache::put(uint64_t _key, uint16_t _width, uint16_t _height,
+                     const unsigned char* _src, size_t _stride) {
+
+    Entry entry { _width, _height, {} };
+    entry.data.resize(size_t(_width) * _height);
+
+    for (size_t y = 0; y < _height; y++) {
+        std::memcpy(&entry.data[y * _width], _src + y * _stride, _width);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_entries.size() >= max_entries) { return; }
+
+    m_entries[_key] = std::move(entry);
+    m_modified = true;
+}
+
+}
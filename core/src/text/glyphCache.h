@@ -0,0 +1,76 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+/* GlyphCache keeps the signed distance fields of rasterized glyphs in a file,
+ * so that glyphs seen in a previous session skip SDF generation on startup.
+ *
+ * Entries are keyed by a hash of the glyph coverage bitmap, its padding and
+ * the SDF radius. All FontContexts of a process share one GlyphCache per file,
+ * see open(); its methods may be called from any thread.
+ */
+class GlyphCache {
+
+public:
+
+    static constexpr size_t max_entries = 16384;
+
+    static uint64_t key(const unsigned char* _bitmap, uint16_t _width, uint16_t _height,
+                        uint16_t _pad, float _sdfRadius);
+
+    // Returns the cache for the file at _path, shared with all other users of
+    // that file in this process. The file is loaded on a background thread,
+    // until then get() misses.
+    static std::shared_ptr<GlyphCache> open(const std::string& _path);
+
+    GlyphCache() = default;
+    ~GlyphCache();
+
+    // Read cached glyphs from the file at _path; the file is written back to
+    // the same path on save(). Glyphs put before keep their distance fields.
+    // Returns false when no valid cache was found.
+    bool load(const std::string& _path);
+
+    // Write the cache file if glyphs were added since it was loaded. Waits
+    // for a background load to finish, so that the file keeps its glyphs.
+    bool save();
+
+    size_t size() const;
+
+    // Copy the distance field for _key into _dst, with rows _stride bytes apart.
+    // Returns false when _key is not cached.
+    bool get(uint64_t _key, uint16_t _width, uint16_t _height,
+             unsigned char* _dst, size_t _stride) const;
+
+    void put(uint64_t _key, uint16_t _width, uint16_t _height,
+             const unsigned char* _src, size_t _stride);
+
+private:
+
+    struct Entry {
+        uint16_t width;
+        uint16_t height;
+        std::vector<unsigned char> data;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::string m_path;
+    bool m_modified = false;
+
+    // Set by open(), joined on destruction
+    std::thread m_loader;
+    bool m_loading = false;
+    std::condition_variable m_loadedCondition;
+};
+
+}
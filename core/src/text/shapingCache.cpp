@@ -0,0 +1,100 @@
+#include "text/shapingCache.h"
+
+#include "util/hash.h"
+
+namespace Tangram {
+
+constexpr size_t ShapingCache::max_atlases;
+
+bool ShapingCache::Key::operator==(const Key& _other) const {
+    return font == _other.font &&
+        fontScale == _other.fontScale &&
+        lineSpacing == _other.lineSpacing &&
+        maxLineWidth == _other.maxLineWidth &&
+        maxLines == _other.maxLines &&
+        wordWrap == _other.wordWrap &&
+        alignments == _other.alignments &&
+        text == _other.text;
+}
+
+size_t ShapingCache::KeyHash::operator()(const Key& _key) const {
+    size_t seed = _key.text.hashCode();
+    hash_combine(seed, _key.font);
+    hash_combine(seed, _key.fontScale);
+    hash_combine(seed, _key.lineSpacing);
+    hash_combine(seed, _key.maxLineWidth);
+    hash_combine(seed, _key.maxLines);
+    hash_combine(seed, _key.wordWrap);
+    hash_combine(seed, _key.alignments);
+    return seed;
+}
+
+const ShapingCache::Entry* ShapingCache::get(const Key& _key) {
+
+    auto it = m_index.find(_key);
+    if (it == m_index.end()) {
+        m_misses++;
+        return nullptr;
+    }
+
+    m_hits++;
+
+    // Move to front
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+    return &it->second->second;
+}
+
+void ShapingCache::put(Key _key, Entry _entry) {
+
+    if (m_maxEntries == 0) { return; }
+
+    auto it = m_index.find(_key);
+    if (it != m_index.end()) {
+        m_entries.erase(it->second);
+        m_index.erase(it);
+    }
+
+    while (m_entries.size() >= m_maxEntries) {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+
+    m_atlases |= _entry.atlases;
+
+    m_entries.emplace_front(std::move(_key), std::move(_entry));
+    m_index.emplace(m_entries.front().first, m_entries.begin());
+}
+
+void ShapingCache::invalidateAtlas(size_t _atlas) {
+
+    if (_atlas >= max_atlases || !m_atlases[_atlas]) { return; }
+
+    m_atlases.reset();
+
+    for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+        if (it->second.atlases[_atlas]) {
+            m_index.erase(it->first);
+            it = m_entries.erase(it);
+        } else {
+            m_atlases |= it->second.atlases;
+            ++it;
+        }
+    }
+}
+
+void ShapingCache::clear() {
+    m_entries.clear();
+    m_index.clear();
+    m_atlases.reset();
+}
+
+ShapingCache::Stats ShapingCache::stats() const {
+    Stats stats;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.entries = m_entries.size();
+    return stats;
+}
+
+}
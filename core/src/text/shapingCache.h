@@ -0,0 +1,101 @@
+#pragma once
+
+#include "labels/textLabel.h"
+
+#include "unicode/unistr.h"
+#include <bitset>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace alfons {
+class Font;
+}
+
+namespace Tangram {
+
+/* ShapingCache keeps the glyph quads, text ranges and bounding box of
+ * laid out label texts, so that texts repeated across tiles (street names,
+ * POI categories, shields) are shaped only once.
+ *
+ * Cached quads reference glyph atlas positions, entries must be dropped with
+ * invalidateAtlas() when an atlas is cleared. The cache is not synchronized,
+ * FontContext accesses it while holding its texture mutex.
+ */
+class ShapingCache {
+
+public:
+
+    static constexpr size_t max_atlases = 64;
+    using AtlasRefs = std::bitset<max_atlases>;
+
+    struct Key {
+        icu::UnicodeString text;
+        const alfons::Font* font;
+        float fontScale;
+        float lineSpacing;
+        uint32_t maxLineWidth;
+        uint32_t maxLines;
+        bool wordWrap;
+        // Bitmask of the text alignments that were laid out
+        uint8_t alignments;
+
+        bool operator==(const Key& _other) const;
+    };
+
+    struct Entry {
+        std::vector<GlyphQuad> quads;
+        // Ranges relative to the first quad
+        TextRange textRanges;
+        glm::vec2 size;
+        AtlasRefs atlases;
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t entries = 0;
+
+        float hitRate() const {
+            size_t total = hits + misses;
+            return total > 0 ? float(hits) / total : 0.f;
+        }
+    };
+
+    ShapingCache(size_t _maxEntries = 4096) : m_maxEntries(_maxEntries) {}
+
+    // Returns the cached layout for _key or nullptr. The entry stays valid until
+    // the next call to put(), invalidateAtlas() or clear().
+    const Entry* get(const Key& _key);
+
+    void put(Key _key, Entry _entry);
+
+    // Drop all entries with glyphs on _atlas
+    void invalidateAtlas(size_t _atlas);
+
+    void clear();
+
+    Stats stats() const;
+
+private:
+
+    struct KeyHash {
+        size_t operator()(const Key& _key) const;
+    };
+
+    using LruList = std::list<std::pair<Key, Entry>>;
+
+    // Most recently used entries at the front
+    LruList m_entries;
+    std::unordered_map<Key, LruList::iterator, KeyHash> m_index;
+
+    // Union of the atlases referenced by all entries
+    AtlasRefs m_atlases;
+
+    size_t m_maxEntries;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+};
+
+}
@@ -78,6 +78,10 @@ public:
 
     const auto& getSelectionFeatures() const { return m_selectionFeatures; }
 
+    /* Time the tile was added to the map until its first draw is traced, see debug/tracer.h */
+    int64_t getTraceTime() const { return m_traceTime; }
+    void setTraceTime(int64_t _time) { m_traceTime = _time; }
+
     auto& rasters() { return m_rasters; }
     const auto& rasters() const { return m_rasters; }
 
@@ -135,6 +139,8 @@ private:
 
     fastmap<uint32_t, std::shared_ptr<Properties>> m_selectionFeatures;
 
+    int64_t m_traceTime = 0;
+
 };
 
 }
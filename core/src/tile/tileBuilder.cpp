@@ -3,6 +3,7 @@
 #include "data/properties.h"
 #include "data/propertyItem.h"
 #include "data/tileSource.h"
+#include "debug/tracer.h"
 #include "gl/mesh.h"
 #include "log.h"
 #include "scene/dataLayer.h"
@@ -110,6 +111,8 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
             builder.second->setup(*tile);
     }
 
+    TraceScope trace("style", "tile", _tileID);
+
     for (const auto& datalayer : m_scene->layers()) {
 
         if (datalayer.source() != _source.name()) { continue; }
@@ -130,6 +133,8 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
         }
     }
 
+    trace.next("label layout");
+
     for (auto& builder : m_styleBuilder) {
 
         builder.second->addLayoutItems(m_labelLayout);
@@ -139,6 +144,8 @@ std::shared_ptr<Tile> TileBuilder::build(TileID _tileID, const TileData& _tileDa
 
     m_labelLayout.process(_tileID, tile->getInverseScale(), tileSize);
 
+    trace.next("meshes");
+
     for (auto& builder : m_styleBuilder) {
         tile->setMesh(builder.second->style(), builder.second->build());
     }
@@ -63,6 +63,9 @@ public:
             m_cacheList.erase(it->second);
             m_cacheMap.erase(it);
             m_cacheUsage -= tile->getMemoryUsage();
+            m_hits++;
+        } else {
+            m_misses++;
         }
         return tile;
     }
@@ -97,6 +100,24 @@ public:
         return poppedTileIDs;
     }
 
+    // Drop least recently used tiles until at least _bytes were freed
+    std::vector<TileCacheKey> evict(size_t _bytes) {
+        std::vector<TileCacheKey> poppedKeys;
+        size_t freed = 0;
+
+        while (freed < _bytes && !m_cacheList.empty()) {
+            auto& entry = m_cacheList.back();
+            size_t usage = entry.tile->getMemoryUsage();
+
+            poppedKeys.push_back(entry.key);
+            freed += usage;
+            m_cacheUsage -= usage;
+            m_cacheMap.erase(entry.key);
+            m_cacheList.pop_back();
+        }
+        return poppedKeys;
+    }
+
     size_t getMemoryUsage() const {
         size_t sum = 0;
         for (auto& entry : m_cacheList) {
@@ -111,12 +132,26 @@ public:
         m_cacheUsage = 0;
     }
 
+    size_t size() const { return m_cacheList.size(); }
+
+    // Number of get() calls that found or missed a tile
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+
+    void resetStats() {
+        m_hits = 0;
+        m_misses = 0;
+    }
+
 private:
     CacheMap m_cacheMap;
     CacheList m_cacheList;
 
     int m_cacheUsage;
     int m_cacheMaxUsage;
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
 };
 
 }
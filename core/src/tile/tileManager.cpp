@@ -28,6 +28,7 @@ TileManager::TileManager(std::shared_ptr<Platform> platform, TileTaskQueue& _til
              platform->requestRender();
 
         } else if (task->hasData()) {
+            task->trace(TileTask::Stage::loaded);
             m_workers.enqueue(task);
 
         } else {
@@ -60,18 +61,60 @@ void TileManager::setTileSources(const std::vector<std::shared_ptr<TileSource>>&
 
     m_tileSets.erase(it, m_tileSets.end());
 
-    // add new sources
+    addTileSources(_sources);
+}
+
+void TileManager::updateTileSources(const std::vector<std::shared_ptr<TileSource>>& _sources,
+                                    const std::set<std::string>& _rebuild, bool _rebuildAll) {
+
+    bool removed = false;
+
+    // Remove tileSets of (non-client) sources that are not part of the new scene
+    auto it = std::remove_if(
+        m_tileSets.begin(), m_tileSets.end(),
+        [&](auto& tileSet) {
+            if (tileSet.clientTileSource) { return false; }
+
+            if (tileSet.source->generateGeometry() &&
+                std::find(_sources.begin(), _sources.end(), tileSet.source) != _sources.end()) {
+                return false;
+            }
+            LOGN("Remove source %s", tileSet.source->name().c_str());
+            removed = true;
+            return true;
+        });
+
+    m_tileSets.erase(it, m_tileSets.end());
+
+    if (removed) { m_tileCache->clear(); }
+
+    // Loaded tiles stay visible until their rebuilt replacement is ready
+    for (auto& tileSet : m_tileSets) {
+        if (_rebuildAll || _rebuild.count(tileSet.source->name()) != 0) {
+            tileSet.source->rebuildTiles();
+        }
+    }
+
+    addTileSources(_sources);
+
+    m_tileSetChanged = true;
+}
+
+void TileManager::addTileSources(const std::vector<std::shared_ptr<TileSource>>& _sources) {
+
     for (const auto& source : _sources) {
 
         if (!source->generateGeometry()) { continue; }
 
-        if (std::find_if(m_tileSets.begin(), m_tileSets.end(),
-                         [&](const TileSet& a) {
-                             return a.source->name() == source->name();
-                         }) == m_tileSets.end()) {
+        auto it = std::find_if(m_tileSets.begin(), m_tileSets.end(),
+                               [&](const TileSet& a) {
+                                   return a.source->name() == source->name();
+                               });
+
+        if (it == m_tileSets.end()) {
             LOGN("add source %s", source->name().c_str());
             m_tileSets.push_back({ source, false });
-        } else {
+        } else if (it->source != source) {
             LOGW("Duplicate named datasource (not added): %s", source->name().c_str());
         }
     }
@@ -124,10 +167,29 @@ void TileManager::clearTileSet(int32_t _sourceId) {
     m_tileSetChanged = true;
 }
 
+size_t TileManager::evictCachedTiles(size_t _bytes) {
+
+    size_t usage = m_tileCache->getMemoryUsage();
+
+    for (auto& key : m_tileCache->evict(_bytes)) {
+        for (auto& tileSet : m_tileSets) {
+            // Keep rasters of tiles that are still in the visible set
+            if (tileSet.source->id() == key.first &&
+                tileSet.tiles.find(key.second) == tileSet.tiles.end()) {
+                tileSet.source->clearRaster(key.second);
+            }
+        }
+    }
+
+    return usage - m_tileCache->getMemoryUsage();
+}
+
 void TileManager::updateTileSets(const View& _view) {
 
     m_tiles.clear();
     m_tilesInProgress = 0;
+    m_tilesPendingUpload = 0;
+    m_uploadBytes = 0;
     m_tileSetChanged = false;
 
     if (!getDebugFlag(DebugFlags::freeze_tiles)) {
@@ -187,18 +249,38 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
     auto& tiles = _tileSet.tiles;
 
     // Check for ready tasks, move Tile to active TileSet and unset Proxies.
+    // Tiles nearest to the view center go first. Once the upload budget is
+    // spent the remaining tiles wait for the next update, so that a single
+    // frame does not upload all of them; their proxies stay visible meanwhile.
+    m_readyTiles.clear();
     for (auto& it : tiles) {
-        auto& entry = it.second;
-        if (entry.newData()) {
-            clearProxyTiles(_tileSet, it.first, entry, removeTiles);
-            entry.task->complete();
+        if (it.second.newData()) {
+            m_readyTiles.emplace_back(&it.first, &it.second);
+        }
+    }
+    std::sort(m_readyTiles.begin(), m_readyTiles.end(), [](auto& a, auto& b) {
+            return a.second->task->getPriority() < b.second->task->getPriority();
+        });
 
-            entry.tile = std::move(entry.task->tile());
-            entry.task.reset();
-            newTiles = true;
+    for (auto& ready : m_readyTiles) {
+        auto& entry = *ready.second;
 
-            m_tileSetChanged = true;
+        if (m_uploadBudget > 0 && m_uploadBytes > 0 && m_uploadBytes >= m_uploadBudget) {
+            m_tilesPendingUpload++;
+            continue;
         }
+
+        clearProxyTiles(_tileSet, *ready.first, entry, removeTiles);
+        entry.task->complete();
+        entry.task->trace(TileTask::Stage::completed);
+
+        entry.tile = std::move(entry.task->tile());
+        entry.tile->setTraceTime(entry.task->stageTime(TileTask::Stage::completed));
+        entry.task.reset();
+        newTiles = true;
+
+        m_uploadBytes += entry.tile->getMemoryUsage();
+        m_tileSetChanged = true;
     }
 
     const auto& visibleTiles = _tileSet.visibleTiles;
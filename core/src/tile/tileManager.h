@@ -31,6 +31,7 @@ struct ViewState;
 class TileManager {
 
     const static size_t DEFAULT_CACHE_SIZE = 32*1024*1024; // 32 MB
+    const static size_t DEFAULT_UPLOAD_BUDGET = 4*1024*1024; // 4 MB
 
 public:
 
@@ -41,6 +42,13 @@ public:
     /* Sets the tile TileSources */
     void setTileSources(const std::vector<std::shared_ptr<TileSource>>& _sources);
 
+    /* Sets the tile TileSources of an updated scene. Tiles of sources that are
+     * still used are kept; those of sources named in _rebuild, or of all sources
+     * when _rebuildAll is set, are built again and replaced once ready.
+     */
+    void updateTileSources(const std::vector<std::shared_ptr<TileSource>>& _sources,
+                           const std::set<std::string>& _rebuild, bool _rebuildAll);
+
     /* Updates visible tile set and load missing tiles */
     void updateTileSets(const View& _view);
 
@@ -57,6 +65,9 @@ public:
         return m_tilesInProgress > 0;
     }
 
+    /* Returns the number of visible tiles being loaded by the last update */
+    int32_t tilesInProgress() const { return m_tilesInProgress; }
+
     std::shared_ptr<TileSource> getClientTileSource(int32_t sourceID);
 
     void addClientTileSource(std::shared_ptr<TileSource> _source);
@@ -72,6 +83,24 @@ public:
      */
     void setCacheSize(size_t _cacheSize);
 
+    /* Drop cached tiles, least recently used first, until their meshes and
+     * rasters add up to at least _bytes. Returns the number of bytes freed.
+     */
+    size_t evictCachedTiles(size_t _bytes);
+
+    /* @_bytes: Maximum size of new tile meshes and rasters to make visible per
+     * update; these are uploaded to the GPU on the following render. Loaded tiles
+     * that exceed the budget stay pending, nearest to the view center first.
+     * At least one tile is made visible per update; 0 disables the budget.
+     */
+    void setUploadBudget(size_t _bytes) { m_uploadBudget = _bytes; }
+
+    /* Returns the number of loaded tiles waiting for upload budget */
+    int32_t pendingUploads() const { return m_tilesPendingUpload; }
+
+    /* Returns the size of tiles made visible by the last update */
+    size_t uploadBytes() const { return m_uploadBytes; }
+
 protected:
 
     enum class ProxyID : uint8_t {
@@ -204,6 +233,8 @@ protected:
         bool clientTileSource;
     };
 
+    void addTileSources(const std::vector<std::shared_ptr<TileSource>>& _sources);
+
     void updateTileSet(TileSet& tileSet, const ViewState& _view);
 
     void enqueueTask(TileSet& _tileSet, const TileID& _tileID, const ViewState& _view);
@@ -237,6 +268,13 @@ protected:
 
     int32_t m_tilesInProgress = 0;
 
+    size_t m_uploadBudget = DEFAULT_UPLOAD_BUDGET;
+    size_t m_uploadBytes = 0;
+    int32_t m_tilesPendingUpload = 0;
+
+    /* Temporary list of loaded tiles, sorted by load priority */
+    std::vector<std::pair<const TileID*, TileEntry*>> m_readyTiles;
+
     std::vector<TileSet> m_tileSets;
 
     /* Current tiles ready for rendering */
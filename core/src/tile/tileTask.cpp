@@ -1,11 +1,15 @@
 #include "tile/tileTask.h"
 
+#include "data/tileData.h"
+#include "debug/tracer.h"
 #include "data/tileSource.h"
 #include "scene/scene.h"
 #include "tile/tile.h"
 #include "tile/tileBuilder.h"
 #include "util/mapProjection.h"
 
+#include <algorithm>
+
 namespace Tangram {
 
 TileTask::TileTask(TileID& _tileId, std::shared_ptr<TileSource> _source, int _subTask) :
@@ -13,11 +17,52 @@ TileTask::TileTask(TileID& _tileId, std::shared_ptr<TileSource> _source, int _su
     m_subTaskId(_subTask),
     m_source(_source),
     m_sourceGeneration(_source->generation()),
-    m_priority(0) {}
+    m_priority(0) {
+
+    trace(Stage::created);
+}
+
+// Names of the spans that end at each stage
+static const char* s_stageSpans[] = {
+    "created",
+    "load",
+    "wait for decode",
+    "decode",
+    "wait for build",
+    "build",
+    "wait for upload",
+};
+
+void TileTask::trace(Stage _stage) {
+    if (!Tracer::isEnabled()) { return; }
+
+    // Keep 0 for stages that were not traced
+    auto now = std::max<Tracer::Time>(Tracer::now(), 1);
+    size_t stage = static_cast<size_t>(_stage);
+    m_stageTimes[stage] = now;
+
+    for (size_t prev = stage; prev-- > 0;) {
+        if (m_stageTimes[prev] > 0) {
+            Tracer::span(s_stageSpans[stage], "tile", m_stageTimes[prev], now, m_tileId);
+            break;
+        }
+    }
+}
+
+void TileTask::decode(const MapProjection& _projection) {
+
+    m_tileData = m_source->parse(*this, _projection);
+    m_decoded = true;
+}
 
 void TileTask::process(TileBuilder& _tileBuilder) {
 
-    auto tileData = m_source->parse(*this, *_tileBuilder.scene().mapProjection());
+    if (!m_decoded) {
+        decode(*_tileBuilder.scene().mapProjection());
+    }
+
+    auto tileData = std::move(m_tileData);
+    m_decoded = false;
 
     if (tileData) {
         m_tile = _tileBuilder.build(m_tileId, *tileData, *m_source);
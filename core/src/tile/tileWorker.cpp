@@ -4,17 +4,33 @@
 #include "log.h"
 #include "map.h"
 #include "platform.h"
+#include "scene/scene.h"
 #include "tile/tileBuilder.h"
 #include "tile/tileID.h"
 #include "tile/tileTask.h"
+#include "util/mapProjection.h"
 
 #include <algorithm>
+#include <chrono>
 
 #define WORKER_NICENESS 10
 
+// Number of decoded tasks per worker that may wait to be built
+#define BUILD_QUEUE_PER_WORKER 2
+
 namespace Tangram {
 
-TileWorker::TileWorker(std::shared_ptr<Platform> _platform, int _numWorker) : m_platform(_platform) {
+using Clock = std::chrono::steady_clock;
+
+static float elapsedMs(Clock::time_point _start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - _start).count();
+}
+
+TileWorker::TileWorker(std::shared_ptr<Platform> _platform, int _numWorker, int _numDecoder) :
+    m_hasDecoders(_numDecoder > 0),
+    m_buildQueueLimit(std::max(_numWorker, 1) * BUILD_QUEUE_PER_WORKER),
+    m_platform(_platform) {
+
     m_running = true;
 
     for (int i = 0; i < _numWorker; i++) {
@@ -22,6 +38,10 @@ TileWorker::TileWorker(std::shared_ptr<Platform> _platform, int _numWorker) : m_
         worker->thread = std::thread(&TileWorker::run, this, worker.get());
         m_workers.push_back(std::move(worker));
     }
+
+    for (int i = 0; i < _numDecoder; i++) {
+        m_decoders.emplace_back(&TileWorker::runDecoder, this);
+    }
 }
 
 TileWorker::~TileWorker(){
@@ -30,20 +50,54 @@ TileWorker::~TileWorker(){
     }
 }
 
+std::shared_ptr<TileTask> TileWorker::popTask(std::vector<std::shared_ptr<TileTask>>& _queue) {
+
+    // Remove all canceled tasks
+    auto removes = std::remove_if(_queue.begin(), _queue.end(),
+                                  [](const auto& a) { return a->isCanceled(); });
+
+    _queue.erase(removes, _queue.end());
+
+    if (_queue.empty()) {
+        return nullptr;
+    }
+
+    // Pop highest priority tile from queue
+    auto it = std::min_element(_queue.begin(), _queue.end(),
+        [](const auto& a, const auto& b) {
+            if (a->isProxy() != b->isProxy()) {
+                return !a->isProxy();
+            }
+            if (a->source().id() == b->source().id() &&
+                a->sourceGeneration() != b->sourceGeneration()) {
+                return a->sourceGeneration() < b->sourceGeneration();
+            }
+            return a->getPriority() < b->getPriority();
+        });
+
+    auto task = std::move(*it);
+    _queue.erase(it);
+
+    return task;
+}
+
 void TileWorker::run(Worker* instance) {
 
     setCurrentThreadPriority(WORKER_NICENESS);
 
     std::unique_ptr<TileBuilder> builder;
 
+    auto& queue = m_hasDecoders ? m_buildQueue : m_queue;
+    auto& condition = m_hasDecoders ? m_buildCondition : m_condition;
+
     while (true) {
 
         std::shared_ptr<TileTask> task;
         {
             std::unique_lock<std::mutex> lock(m_mutex);
 
-            m_condition.wait(lock, [&, this]{
-                    return !m_running || !m_queue.empty();
+            condition.wait(lock, [&, this]{
+                    return !m_running || (!m_paused && !queue.empty());
                 });
 
             if (instance->tileBuilder) {
@@ -60,47 +114,151 @@ void TileWorker::run(Worker* instance) {
                 continue;
             }
 
-            // Remove all canceled tasks
-            auto removes = std::remove_if(m_queue.begin(), m_queue.end(),
-                                          [](const auto& a) { return a->isCanceled(); });
+            task = popTask(queue);
+            if (task) { m_building++; }
+        }
+
+        if (m_hasDecoders) {
+            // Let decoders fill the free space in the build queue
+            m_condition.notify_all();
+        }
+
+        if (!task) {
+            continue;
+        }
+
+        build(*builder, *task);
+
+        bool idle = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_building--;
+            idle = m_paused && m_building == 0;
+        }
+        if (idle) {
+            m_idleCondition.notify_all();
+        }
+    }
+}
+
+void TileWorker::build(TileBuilder& _builder, TileTask& _task) {
+
+    if (_task.isCanceled()) {
+        return;
+    }
+
+    if (!_task.isDecoded()) {
+        auto start = Clock::now();
+        _task.trace(TileTask::Stage::decoding);
+        _task.decode(*_builder.scene().mapProjection());
+        _task.trace(TileTask::Stage::decoded);
+        m_decodeTime.record(elapsedMs(start));
+
+        if (_task.isCanceled()) {
+            return;
+        }
+    }
+
+    auto start = Clock::now();
+    _task.trace(TileTask::Stage::building);
+    _task.process(_builder);
+    _task.trace(TileTask::Stage::built);
+    m_buildTime.record(elapsedMs(start));
+
+    m_platform->requestRender();
+}
 
-            m_queue.erase(removes, m_queue.end());
+void TileWorker::runDecoder() {
 
-            if (m_queue.empty()) {
+    setCurrentThreadPriority(WORKER_NICENESS);
+
+    while (true) {
+
+        std::shared_ptr<TileTask> task;
+        std::shared_ptr<Scene> scene;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_condition.wait(lock, [this]{
+                    return !m_running || (m_scene && !m_queue.empty() &&
+                                          m_buildQueue.size() + m_decoding < m_buildQueueLimit);
+                });
+
+            // Check if thread should stop
+            if (!m_running) {
+                break;
+            }
+
+            task = popTask(m_queue);
+            if (!task) {
                 continue;
             }
+            scene = m_scene;
+            m_decoding++;
+        }
 
-            // Pop highest priority tile from queue
-            auto it = std::min_element(m_queue.begin(), m_queue.end(),
-                [](const auto& a, const auto& b) {
-                    if (a->isProxy() != b->isProxy()) {
-                        return !a->isProxy();
-                    }
-                    if (a->source().id() == b->source().id() &&
-                        a->sourceGeneration() != b->sourceGeneration()) {
-                        return a->sourceGeneration() < b->sourceGeneration();
-                    }
-                    return a->getPriority() < b->getPriority();
-                });
+        auto start = Clock::now();
+        task->trace(TileTask::Stage::decoding);
+        task->decode(*scene->mapProjection());
+        task->trace(TileTask::Stage::decoded);
+        m_decodeTime.record(elapsedMs(start));
 
-            task = std::move(*it);
-            m_queue.erase(it);
+        bool decoded = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_decoding--;
+
+            // Drop tasks that were canceled while being decoded
+            if (m_running && !task->isCanceled()) {
+                m_buildQueue.push_back(std::move(task));
+                decoded = true;
+            }
         }
 
-        if (task->isCanceled()) {
-            continue;
+        if (decoded) {
+            m_buildCondition.notify_one();
+        } else {
+            m_condition.notify_one();
         }
+    }
+}
 
-        task->process(*builder);
+void TileWorker::setScene(std::shared_ptr<Scene>& _scene) {
+    std::vector<std::unique_ptr<TileBuilder>> builders;
+    for (size_t i = 0; i < m_workers.size(); i++) {
+        builders.push_back(std::make_unique<TileBuilder>(_scene));
+    }
 
-        m_platform->requestRender();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_scene = _scene;
+        for (size_t i = 0; i < m_workers.size(); i++) {
+            m_workers[i]->tileBuilder = std::move(builders[i]);
+        }
     }
+    m_condition.notify_all();
 }
 
-void TileWorker::setScene(std::shared_ptr<Scene>& _scene) {
-    for (auto& worker : m_workers) {
-        worker->tileBuilder = std::make_unique<TileBuilder>(_scene);
+void TileWorker::runWhileIdle(const std::function<void()>& _fn) {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_paused = true;
+        m_idleCondition.wait(lock, [this]{ return m_building == 0; });
+    }
+
+    _fn();
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_paused = false;
     }
+    m_condition.notify_all();
+    m_buildCondition.notify_all();
+}
+
+size_t TileWorker::pendingTasks() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_queue.size() + m_buildQueue.size();
 }
 
 void TileWorker::enqueue(std::shared_ptr<TileTask> task) {
@@ -121,12 +279,18 @@ void TileWorker::stop() {
     }
 
     m_condition.notify_all();
+    m_buildCondition.notify_all();
 
     for (auto& worker : m_workers) {
         worker->thread.join();
     }
+    for (auto& decoder : m_decoders) {
+        decoder.join();
+    }
 
     m_queue.clear();
+    m_buildQueue.clear();
+    m_scene.reset();
 }
 
 }
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "tile/tileTask.h"
+#include "util/histogram.h"
 #include "util/jobQueue.h"
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -17,11 +19,18 @@ class Platform;
 class Scene;
 class TileBuilder;
 
+/*
+ * TileWorker processes TileTasks in two stages: decoder threads parse the
+ * tile data and pass the decoded tasks through a bounded queue to worker
+ * threads, which style and build the tiles. The bound keeps decoders from
+ * running ahead of the workers. Without decoder threads the workers also
+ * decode the tasks they build.
+ */
 class TileWorker : public TileTaskQueue {
 
 public:
 
-    TileWorker(std::shared_ptr<Platform> _platform, int _numWorker);
+    TileWorker(std::shared_ptr<Platform> _platform, int _numWorker, int _numDecoder = 0);
 
     ~TileWorker();
 
@@ -33,6 +42,22 @@ public:
 
     void setScene(std::shared_ptr<Scene>& _scene);
 
+    // Calls _fn on the calling thread while no worker builds a tile: waits for
+    // the tiles being built and holds back further builds until _fn returns.
+    void runWhileIdle(const std::function<void()>& _fn);
+
+    // Number of tasks waiting to be decoded or built
+    size_t pendingTasks();
+
+    // Time in ms spent on decoding and on building tiles
+    const Histogram& decodeTime() const { return m_decodeTime; }
+    const Histogram& buildTime() const { return m_buildTime; }
+
+    void resetTimes() {
+        m_decodeTime.reset();
+        m_buildTime.reset();
+    }
+
 private:
 
     struct Worker {
@@ -42,15 +67,50 @@ private:
 
     void run(Worker* instance);
 
+    void build(TileBuilder& _builder, TileTask& _task);
+
+    void runDecoder();
+
+    // Removes canceled tasks from _queue and pops the one to process next.
+    // Must be called while holding m_mutex.
+    std::shared_ptr<TileTask> popTask(std::vector<std::shared_ptr<TileTask>>& _queue);
+
     bool m_running;
 
+    // Whether tasks are decoded by decoder threads before the workers get them
+    const bool m_hasDecoders;
+
     std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_decoders;
 
+    // Notifies the threads of the first stage about new tasks and, with
+    // decoders, about room in the build queue.
     std::condition_variable m_condition;
+    // Notifies workers about decoded tasks
+    std::condition_variable m_buildCondition;
 
     std::mutex m_mutex;
     std::vector<std::shared_ptr<TileTask>> m_queue;
 
+    // Decoded tasks waiting for a worker and the number of tasks being
+    // decoded. Together they are kept below m_buildQueueLimit.
+    std::vector<std::shared_ptr<TileTask>> m_buildQueue;
+    size_t m_decoding = 0;
+    size_t m_buildQueueLimit;
+
+    // Number of tasks being built by workers, and whether workers wait with
+    // further builds for runWhileIdle()
+    size_t m_building = 0;
+    bool m_paused = false;
+    // Notifies runWhileIdle() when the last build finished
+    std::condition_variable m_idleCondition;
+
+    // Scene providing the projection for decoding
+    std::shared_ptr<Scene> m_scene;
+
+    Histogram m_decodeTime;
+    Histogram m_buildTime;
+
     std::shared_ptr<Platform> m_platform;
 };
 
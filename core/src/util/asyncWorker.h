@@ -1,15 +1,23 @@
+#pragma once
+
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace Tangram {
 
 class AsyncWorker {
 public:
 
-    AsyncWorker() {
-        thread = std::thread(&AsyncWorker::run, this);
+    // Tasks run in the order they were enqueued when there is only one
+    // thread, otherwise concurrently
+    explicit AsyncWorker(size_t _threads = 1) {
+        for (size_t i = 0; i < _threads; i++) {
+            m_threads.emplace_back(&AsyncWorker::run, this);
+        }
     }
 
     ~AsyncWorker() {
@@ -18,7 +26,9 @@ public:
             m_running = false;
         }
         m_condition.notify_all();
-        thread.join();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
     }
 
     void enqueue(std::function<void()> _task) {
@@ -48,7 +58,7 @@ private:
         }
     }
 
-    std::thread thread;
+    std::vector<std::thread> m_threads;
     bool m_running = true;
     std::condition_variable m_condition;
     std::mutex m_mutex;
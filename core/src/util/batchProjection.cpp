@@ -0,0 +1,123 @@
+#include "util/batchProjection.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define TANGRAM_PROJECT_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define TANGRAM_PROJECT_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Tangram {
+
+static inline void projectPointsScalar(const glm::mat4& _mvp, glm::vec2 _halfScreen,
+                                       const float* _x, const float* _y, size_t _count,
+                                       float* _sx, float* _sy, float* _z, float* _w) {
+
+    for (size_t i = 0; i < _count; i++) {
+        float x = _x[i];
+        float y = _y[i];
+
+        float cx = _mvp[0][0] * x + _mvp[1][0] * y + _mvp[3][0];
+        float cy = _mvp[0][1] * x + _mvp[1][1] * y + _mvp[3][1];
+        float cz = _mvp[0][2] * x + _mvp[1][2] * y + _mvp[3][2];
+        float cw = _mvp[0][3] * x + _mvp[1][3] * y + _mvp[3][3];
+
+        _sx[i] = (cx / cw + 1.f) * _halfScreen.x;
+        _sy[i] = (1.f - cy / cw) * _halfScreen.y;
+        _z[i] = cz / cw;
+        _w[i] = cw;
+    }
+}
+
+void projectPoints(const glm::mat4& _mvp, glm::vec2 _screenSize,
+                   const float* _x, const float* _y, size_t _count,
+                   float* _sx, float* _sy, float* _z, float* _w) {
+
+    glm::vec2 halfScreen = _screenSize * 0.5f;
+
+    size_t i = 0;
+
+#if defined(TANGRAM_PROJECT_SSE)
+
+    const __m128 m00 = _mm_set1_ps(_mvp[0][0]), m10 = _mm_set1_ps(_mvp[1][0]), m30 = _mm_set1_ps(_mvp[3][0]);
+    const __m128 m01 = _mm_set1_ps(_mvp[0][1]), m11 = _mm_set1_ps(_mvp[1][1]), m31 = _mm_set1_ps(_mvp[3][1]);
+    const __m128 m02 = _mm_set1_ps(_mvp[0][2]), m12 = _mm_set1_ps(_mvp[1][2]), m32 = _mm_set1_ps(_mvp[3][2]);
+    const __m128 m03 = _mm_set1_ps(_mvp[0][3]), m13 = _mm_set1_ps(_mvp[1][3]), m33 = _mm_set1_ps(_mvp[3][3]);
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 hx = _mm_set1_ps(halfScreen.x);
+    const __m128 hy = _mm_set1_ps(halfScreen.y);
+
+    for (; i + 4 <= _count; i += 4) {
+        __m128 x = _mm_loadu_ps(_x + i);
+        __m128 y = _mm_loadu_ps(_y + i);
+
+        __m128 cx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), m30);
+        __m128 cy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), m31);
+        __m128 cz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, x), _mm_mul_ps(m12, y)), m32);
+        __m128 cw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m03, x), _mm_mul_ps(m13, y)), m33);
+
+        _mm_storeu_ps(_sx + i, _mm_mul_ps(_mm_add_ps(_mm_div_ps(cx, cw), one), hx));
+        _mm_storeu_ps(_sy + i, _mm_mul_ps(_mm_sub_ps(one, _mm_div_ps(cy, cw)), hy));
+        _mm_storeu_ps(_z + i, _mm_div_ps(cz, cw));
+        _mm_storeu_ps(_w + i, cw);
+    }
+
+#elif defined(TANGRAM_PROJECT_NEON)
+
+    const float32x4_t m00 = vdupq_n_f32(_mvp[0][0]), m10 = vdupq_n_f32(_mvp[1][0]), m30 = vdupq_n_f32(_mvp[3][0]);
+    const float32x4_t m01 = vdupq_n_f32(_mvp[0][1]), m11 = vdupq_n_f32(_mvp[1][1]), m31 = vdupq_n_f32(_mvp[3][1]);
+    const float32x4_t m02 = vdupq_n_f32(_mvp[0][2]), m12 = vdupq_n_f32(_mvp[1][2]), m32 = vdupq_n_f32(_mvp[3][2]);
+    const float32x4_t m03 = vdupq_n_f32(_mvp[0][3]), m13 = vdupq_n_f32(_mvp[1][3]), m33 = vdupq_n_f32(_mvp[3][3]);
+    const float32x4_t one = vdupq_n_f32(1.f);
+    const float32x4_t hx = vdupq_n_f32(halfScreen.x);
+    const float32x4_t hy = vdupq_n_f32(halfScreen.y);
+
+    for (; i + 4 <= _count; i += 4) {
+        float32x4_t x = vld1q_f32(_x + i);
+        float32x4_t y = vld1q_f32(_y + i);
+
+        float32x4_t cx = vmlaq_f32(vmlaq_f32(m30, m00, x), m10, y);
+        float32x4_t cy = vmlaq_f32(vmlaq_f32(m31, m01, x), m11, y);
+        float32x4_t cz = vmlaq_f32(vmlaq_f32(m32, m02, x), m12, y);
+        float32x4_t cw = vmlaq_f32(vmlaq_f32(m33, m03, x), m13, y);
+
+#if defined(__aarch64__)
+        float32x4_t invw = vdivq_f32(one, cw);
+#else
+        // ARMv7 has no vector divide: refine the reciprocal estimate twice
+        float32x4_t invw = vrecpeq_f32(cw);
+        invw = vmulq_f32(vrecpsq_f32(cw, invw), invw);
+        invw = vmulq_f32(vrecpsq_f32(cw, invw), invw);
+#endif
+
+        vst1q_f32(_sx + i, vmulq_f32(vmlaq_f32(one, cx, invw), hx));
+        vst1q_f32(_sy + i, vmulq_f32(vmlsq_f32(one, cy, invw), hy));
+        vst1q_f32(_z + i, vmulq_f32(cz, invw));
+        vst1q_f32(_w + i, cw);
+    }
+
+#endif
+
+    projectPointsScalar(_mvp, halfScreen, _x + i, _y + i, _count - i,
+                        _sx + i, _sy + i, _z + i, _w + i);
+}
+
+void BatchProjection::project(const glm::mat4& _mvp, glm::vec2 _screenSize) {
+
+    size_t count = m_x.size();
+
+    m_sx.resize(count);
+    m_sy.resize(count);
+    m_z.resize(count);
+    m_w.resize(count);
+
+    m_halfScreen = _screenSize * 0.5f;
+
+    if (count == 0) { return; }
+
+    projectPoints(_mvp, _screenSize, m_x.data(), m_y.data(), count,
+                  m_sx.data(), m_sy.data(), m_z.data(), m_w.data());
+}
+
+}
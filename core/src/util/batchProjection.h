@@ -0,0 +1,77 @@
+#pragma once
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include <vector>
+
+namespace Tangram {
+
+/* Projects points on the tile plane (z = 0, w = 1) by a model-view-projection
+ * matrix and maps them to screen space.
+ * _x, _y: model space input coordinates of _count points
+ * _sx, _sy: screen space output, top-left origin with y pointing down
+ * _z: depth in normalized device coordinates
+ * _w: clip space w, points with _w <= 0 are behind the camera and their
+ *     other outputs are undefined.
+ * Uses SSE or NEON when available, four points per iteration.
+ */
+void projectPoints(const glm::mat4& _mvp, glm::vec2 _screenSize,
+                   const float* _x, const float* _y, size_t _count,
+                   float* _sx, float* _sy, float* _z, float* _w);
+
+/* BatchProjection collects the model space points of many labels as
+ * structure-of-arrays so that they can be projected in a single call
+ * to projectPoints
+ */
+class BatchProjection {
+
+public:
+
+    // Append a model space point, returns the index of the point in the batch
+    size_t add(glm::vec2 _point) {
+        m_x.push_back(_point.x);
+        m_y.push_back(_point.y);
+        return m_x.size() - 1;
+    }
+
+    size_t size() const { return m_x.size(); }
+
+    void clear() {
+        m_x.clear();
+        m_y.clear();
+    }
+
+    // Project all points added since the last clear()
+    void project(const glm::mat4& _mvp, glm::vec2 _screenSize);
+
+    // Whether the point at _index is behind the camera
+    bool clipped(size_t _index) const { return m_w[_index] <= 0.f; }
+
+    glm::vec2 screenPosition(size_t _index) const {
+        return { m_sx[_index], m_sy[_index] };
+    }
+
+    // Position of the point at _index in normalized device coordinates
+    glm::vec3 ndc(size_t _index) const {
+        return { m_sx[_index] / m_halfScreen.x - 1.f,
+                 1.f - m_sy[_index] / m_halfScreen.y,
+                 m_z[_index] };
+    }
+
+private:
+
+    // Model space input
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+
+    // Projected output
+    std::vector<float> m_sx;
+    std::vector<float> m_sy;
+    std::vector<float> m_z;
+    std::vector<float> m_w;
+
+    glm::vec2 m_halfScreen;
+};
+
+}
@@ -72,6 +72,32 @@ glm::vec4 worldToClipSpace(const glm::mat4& _mvp, const glm::vec4& _worldPositio
     return _mvp * _worldPosition;
 }
 
+bool isBoxOutsideClipSpace(const glm::mat4& _mvp, const glm::vec3& _min, const glm::vec3& _max) {
+
+    // Bit per side of the clip volume that all corners are outside of
+    int outside = 0x1f;
+
+    for (int i = 0; i < 8; i++) {
+        glm::vec4 corner((i & 1) ? _max.x : _min.x,
+                         (i & 2) ? _max.y : _min.y,
+                         (i & 4) ? _max.z : _min.z, 1.0);
+
+        glm::vec4 clip = worldToClipSpace(_mvp, corner);
+
+        int sides = 0;
+        if (clip.x < -clip.w) { sides |= 0x01; }
+        if (clip.x > clip.w) { sides |= 0x02; }
+        if (clip.y < -clip.w) { sides |= 0x04; }
+        if (clip.y > clip.w) { sides |= 0x08; }
+        if (clip.w <= 0.0f) { sides |= 0x10; }
+
+        outside &= sides;
+        if (outside == 0) { return false; }
+    }
+
+    return true;
+}
+
 glm::vec2 clipToScreenSpace(const glm::vec4& _clipCoords, const glm::vec2& _screenSize) {
     glm::vec2 halfScreen = glm::vec2(_screenSize * 0.5f);
 
@@ -133,6 +133,10 @@ float angleBetweenPoints(const glm::vec2& _p1, const glm::vec2& _p2);
 /* Computes the clip coordinates from position in world space and a model view matrix */
 glm::vec4 worldToClipSpace(const glm::mat4& _mvp, const glm::vec4& _worldPosition);
 
+/* Whether the box from _min to _max is entirely outside of one side of the clip volume
+ * after transformation by _mvp, near and far planes are not tested */
+bool isBoxOutsideClipSpace(const glm::mat4& _mvp, const glm::vec3& _min, const glm::vec3& _max);
+
 /* Computes the screen coordinates from a coordinate in clip space and a screen size */
 glm::vec2 clipToScreenSpace(const glm::vec4& _clipCoords, const glm::vec2& _screenSize);
 
@@ -0,0 +1,66 @@
+#include "util/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Tangram {
+
+Histogram::Histogram() {
+    reset();
+}
+
+float Histogram::bucketLimit(size_t _bucket) {
+    if (_bucket + 1 >= bucketCount) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return std::ldexp(0.25f, _bucket);
+}
+
+void Histogram::record(float _ms) {
+    size_t bucket = 0;
+    while (bucket + 1 < bucketCount && _ms > bucketLimit(bucket)) {
+        bucket++;
+    }
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+
+    double sum = m_sum.load(std::memory_order_relaxed);
+    while (!m_sum.compare_exchange_weak(sum, sum + _ms, std::memory_order_relaxed)) {}
+
+    float max = m_max.load(std::memory_order_relaxed);
+    while (_ms > max && !m_max.compare_exchange_weak(max, _ms, std::memory_order_relaxed)) {}
+}
+
+void Histogram::reset() {
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+float Histogram::mean() const {
+    uint64_t n = count();
+    if (n == 0) { return 0; }
+    return m_sum.load(std::memory_order_relaxed) / n;
+}
+
+float Histogram::percentile(float _fraction) const {
+    uint64_t n = count();
+    if (n == 0) { return 0; }
+
+    // Rank of the value that the percentile falls on
+    uint64_t rank = std::max<uint64_t>(1, std::ceil(_fraction * n));
+    uint64_t total = 0;
+    for (size_t i = 0; i < bucketCount; i++) {
+        total += bucket(i);
+        if (total >= rank) {
+            return std::fmin(bucketLimit(i), max());
+        }
+    }
+    return max();
+}
+
+}
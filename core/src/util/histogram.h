@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Tangram {
+
+// Histogram records durations in milliseconds into fixed buckets. The upper
+// limit of each bucket is twice the previous one, starting at 0.25ms; the
+// last bucket holds everything above. Recording and reading are lock-free,
+// so worker threads can record while another thread reads the values.
+
+class Histogram {
+
+public:
+    static constexpr size_t bucketCount = 20;
+
+    Histogram();
+
+    // Upper limit of the bucket in ms, infinity for the last one
+    static float bucketLimit(size_t _bucket);
+
+    void record(float _ms);
+
+    void reset();
+
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+
+    uint64_t bucket(size_t _bucket) const { return m_buckets[_bucket].load(std::memory_order_relaxed); }
+
+    float mean() const;
+
+    // Upper limit of the bucket that contains the given fraction (0 to 1) of
+    // the recorded values, or the largest recorded value for the last bucket
+    float percentile(float _fraction) const;
+
+    float max() const { return m_max.load(std::memory_order_relaxed); }
+
+private:
+    std::array<std::atomic<uint64_t>, bucketCount> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<double> m_sum;
+    std::atomic<float> m_max;
+};
+
+}
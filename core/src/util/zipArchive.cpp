@@ -1,7 +1,25 @@
 #include "zipArchive.h"
 
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace Tangram {
 
+// Size and signature of the local file header that precedes entry data
+constexpr size_t LOCAL_HEADER_SIZE = 30;
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+
+static uint32_t readLE(const char* data, size_t bytes) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        value |= uint32_t(uint8_t(data[i])) << (8 * i);
+    }
+    return value;
+}
+
 ZipArchive::ZipArchive() {
     mz_zip_zero_struct(&minizData);
 }
@@ -15,7 +33,40 @@ bool ZipArchive::loadFromMemory(std::vector<char> compressedArchiveData) {
     reset();
     // Initialize the buffer and archive with the input data.
     buffer.swap(compressedArchiveData);
-    if (!mz_zip_reader_init_mem(&minizData, buffer.data(), buffer.size(), 0)) {
+    return loadEntries(buffer.data(), buffer.size());
+}
+
+bool ZipArchive::loadFromFile(const std::string& path) {
+    // Reset to an empty state.
+    reset();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after closing the file.
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    mappedData = static_cast<char*>(data);
+    mappedSize = fileStat.st_size;
+
+    if (!loadEntries(mappedData, mappedSize)) {
+        reset();
+        return false;
+    }
+    return true;
+}
+
+bool ZipArchive::loadEntries(const char* data, size_t size) {
+    if (!mz_zip_reader_init_mem(&minizData, data, size, 0)) {
         return false;
     }
     // Scan the archive entries into a list.
@@ -27,6 +78,17 @@ bool ZipArchive::loadFromMemory(std::vector<char> compressedArchiveData) {
         if (mz_zip_reader_file_stat(&minizData, i, &stats)) {
             entry.path = stats.m_filename;
             entry.uncompressedSize = stats.m_uncomp_size;
+
+            // Find the data of stored entries behind their local header.
+            size_t offset = stats.m_local_header_ofs;
+            if (stats.m_method == 0 && stats.m_comp_size == stats.m_uncomp_size &&
+                offset + LOCAL_HEADER_SIZE <= size &&
+                readLE(data + offset, 4) == LOCAL_HEADER_SIGNATURE) {
+                offset += LOCAL_HEADER_SIZE + readLE(data + offset + 26, 2) + readLE(data + offset + 28, 2);
+                if (offset + entry.uncompressedSize <= size) {
+                    entry.storedData = data + offset;
+                }
+            }
         }
         entryList.push_back(entry);
     }
@@ -47,6 +109,10 @@ bool ZipArchive::decompressEntry(const Entry* entry, char* output) {
     if (entry == nullptr || entry < entryList.data() || entry >= entryList.data() + entryList.size()) {
         return false;
     }
+    if (entry->storedData) {
+        std::copy(entry->storedData, entry->storedData + entry->uncompressedSize, output);
+        return true;
+    }
     // Get the index of the entry (this arithmetic is only legal in an array).
     size_t index = entry - entryList.data();
     size_t size = entry->uncompressedSize;
@@ -60,6 +126,12 @@ void ZipArchive::reset() {
     // Empty the buffer and entry list.
     buffer.clear();
     entryList.clear();
+    // Unmap the archive file.
+    if (mappedData) {
+        munmap(mappedData, mappedSize);
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
 }
 
 }
@@ -17,6 +17,9 @@ public:
     struct Entry {
         std::string path;
         size_t uncompressedSize = 0;
+        // Data of entries stored without compression, pointing into the
+        // archive data; null for compressed entries.
+        const char* storedData = nullptr;
     };
 
     // Create an empty archive.
@@ -35,6 +38,11 @@ public:
     // data is loaded or the archive is destroyed.
     bool loadFromMemory(std::vector<char> compressedArchiveData);
 
+    // Load a zip archive from a file by mapping it into memory, so that only
+    // the pages of entries that are read become resident. Returns false if
+    // the file can't be mapped or is not a zip archive.
+    bool loadFromFile(const std::string& path);
+
     // Empty the archive.
     void reset();
 
@@ -52,9 +60,16 @@ public:
     bool decompressEntry(const Entry* entry, char* output);
 
 protected:
+    // Scan the entries of the archive data in minizData.
+    bool loadEntries(const char* data, size_t size);
+
     // Buffer of compressed zip archive data.
     std::vector<char> buffer;
 
+    // Memory mapping of a zip archive file, used instead of the buffer.
+    char* mappedData = nullptr;
+    size_t mappedSize = 0;
+
     // List of file entries in the archive.
     std::vector<Entry> entryList;
 
@@ -422,6 +422,7 @@ void View::updateMatrices() {
     m_invNormalMatrix = glm::inverse(m_normalMatrix);
 
     m_dirtyMatrices = false;
+    m_generation++;
 
 }
 
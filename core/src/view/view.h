@@ -186,6 +186,9 @@ public:
     /* Returns true if the view properties have changed since the last call to update() */
     bool changedOnLastUpdate() const { return m_changed; }
 
+    /* Incremented whenever the view and projection matrices are updated */
+    uint32_t generation() const { return m_generation; }
+
     /* TODO: API for setting these */
     constexpr static float s_maxZoom = 20.5;
     constexpr static float s_minZoom = 0.0;
@@ -244,6 +247,7 @@ protected:
     bool m_dirtyMatrices;
     bool m_dirtyTiles;
     bool m_changed;
+    uint32_t m_generation = 1;
 
 };
 
@@ -2,6 +2,7 @@
 
 #include "data/properties.h"
 #include "data/propertyItem.h"
+#include "gl/hardware.h"
 #include "log.h"
 #include "map.h"
 #include "util/url.h"
@@ -29,6 +30,10 @@
 PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOESEXT = 0;
 PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT = 0;
 PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT = 0;
+PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESEXT = 0;
+PFNGLPROGRAMBINARYOESPROC glProgramBinaryOESEXT = 0;
+PFNGLDRAWELEMENTSINSTANCEDEXTPROC glDrawElementsInstancedEXTEXT = 0;
+PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisorEXTEXT = 0;
 
 namespace Tangram {
 
@@ -466,20 +471,31 @@ void featurePickCallback(jobject listener, const Tangram::FeaturePickResult* fea
     jniEnv->DeleteGlobalRef(listener);
 }
 
-void initGLExtensions() {
-    if (glExtensionsLoaded) {
-        return;
-    }
-
+static void loadGLExtensions() {
     void* libhandle = dlopen("libGLESv2.so", RTLD_LAZY);
 
     glBindVertexArrayOESEXT = (PFNGLBINDVERTEXARRAYOESPROC) dlsym(libhandle, "glBindVertexArrayOES");
     glDeleteVertexArraysOESEXT = (PFNGLDELETEVERTEXARRAYSOESPROC) dlsym(libhandle, "glDeleteVertexArraysOES");
     glGenVertexArraysOESEXT = (PFNGLGENVERTEXARRAYSOESPROC) dlsym(libhandle, "glGenVertexArraysOES");
+    glGetProgramBinaryOESEXT = (PFNGLGETPROGRAMBINARYOESPROC) dlsym(libhandle, "glGetProgramBinaryOES");
+    glProgramBinaryOESEXT = (PFNGLPROGRAMBINARYOESPROC) dlsym(libhandle, "glProgramBinaryOES");
+    glDrawElementsInstancedEXTEXT = (PFNGLDRAWELEMENTSINSTANCEDEXTPROC) dlsym(libhandle, "glDrawElementsInstancedEXT");
+    glVertexAttribDivisorEXTEXT = (PFNGLVERTEXATTRIBDIVISOREXTPROC) dlsym(libhandle, "glVertexAttribDivisorEXT");
 
     glExtensionsLoaded = true;
 }
 
+void initGLExtensions() {
+    if (!glExtensionsLoaded) {
+        loadGLExtensions();
+    }
+
+    Hardware::supportsProgramBinary = Hardware::hasExtension("GL_OES_get_program_binary") &&
+        glGetProgramBinaryOESEXT && glProgramBinaryOESEXT;
+    Hardware::supportsInstancedArrays = Hardware::hasExtension("GL_EXT_instanced_arrays") &&
+        glDrawElementsInstancedEXTEXT && glVertexAttribDivisorEXTEXT;
+}
+
 void AndroidPlatform::sceneReadyCallback(SceneID id, const SceneError* sceneError) {
 
     JniThreadBinding jniEnv(jvm);
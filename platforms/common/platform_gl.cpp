@@ -287,6 +287,29 @@ void GL::genVertexArrays(GLsizei n, GLuint *arrays) {
     GL_CHECK(glGenVertexArrays(n, arrays));
 }
 
+// Program binaries
+void GL::getProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length,
+                          GLenum *binaryFormat, void *binary) {
+    GL_CHECK(glGetProgramBinary(program, bufSize, length, binaryFormat, binary));
+}
+void GL::programBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {
+    GL_CHECK(glProgramBinary(program, binaryFormat, binary, length));
+}
+void GL::programParameteri(GLuint program, GLenum pname, GLint value) {
+#ifdef TANGRAM_LINUX
+    GL_CHECK(glProgramParameteri(program, pname, value));
+#endif
+}
+
+// Instanced arrays
+void GL::drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices,
+                               GLsizei primcount) {
+    GL_CHECK(glDrawElementsInstanced(mode, count, type, indices, primcount));
+}
+void GL::vertexAttribDivisor(GLuint index, GLuint divisor) {
+    GL_CHECK(glVertexAttribDivisor(index, divisor));
+}
+
 // Framebuffer
 void GL::bindFramebuffer(GLenum target, GLuint framebuffer) {
     GL_CHECK(glBindFramebuffer(target, framebuffer));
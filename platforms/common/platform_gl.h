@@ -13,10 +13,18 @@
 extern PFNGLBINDVERTEXARRAYOESPROC glBindVertexArrayOESEXT;
 extern PFNGLDELETEVERTEXARRAYSOESPROC glDeleteVertexArraysOESEXT;
 extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
+extern PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESEXT;
+extern PFNGLPROGRAMBINARYOESPROC glProgramBinaryOESEXT;
+extern PFNGLDRAWELEMENTSINSTANCEDEXTPROC glDrawElementsInstancedEXTEXT;
+extern PFNGLVERTEXATTRIBDIVISOREXTPROC glVertexAttribDivisorEXTEXT;
 
 #define glDeleteVertexArrays glDeleteVertexArraysOESEXT
 #define glGenVertexArrays glGenVertexArraysOESEXT
 #define glBindVertexArray glBindVertexArrayOESEXT
+#define glGetProgramBinary glGetProgramBinaryOESEXT
+#define glProgramBinary glProgramBinaryOESEXT
+#define glDrawElementsInstanced glDrawElementsInstancedEXTEXT
+#define glVertexAttribDivisor glVertexAttribDivisorEXTEXT
 #endif // TANGRAM_ANDROID
 
 #ifdef TANGRAM_IOS
@@ -25,6 +33,8 @@ extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
 #define glDeleteVertexArrays glDeleteVertexArraysOES
 #define glGenVertexArrays glGenVertexArraysOES
 #define glBindVertexArray glBindVertexArrayOES
+#define glDrawElementsInstanced glDrawElementsInstancedEXT
+#define glVertexAttribDivisor glVertexAttribDivisorEXT
 #endif // TANGRAM_IOS
 
 #ifdef TANGRAM_OSX
@@ -36,11 +46,18 @@ extern PFNGLGENVERTEXARRAYSOESPROC glGenVertexArraysOESEXT;
 #define glDeleteVertexArrays glDeleteVertexArraysAPPLE
 #define glGenVertexArrays glGenVertexArraysAPPLE
 #define glBindVertexArray glBindVertexArrayAPPLE
+#define glDrawElementsInstanced glDrawElementsInstancedARB
+#define glVertexAttribDivisor glVertexAttribDivisorARB
 #endif // TANGRAM_OSX
 
 #ifdef TANGRAM_LINUX
 #define GL_GLEXT_PROTOTYPES
+#ifdef TANGRAM_HEADLESS
+#include <GL/gl.h>
+#include <GL/glext.h>
+#else
 #include <GLFW/glfw3.h>
+#endif
 #endif // TANGRAM_LINUX
 
 #ifdef TANGRAM_RPI
@@ -57,8 +74,20 @@ static void glBindVertexArray(GLuint array) {}
 static void glDeleteVertexArrays(GLsizei n, const GLuint *arrays) {}
 static void glGenVertexArrays(GLsizei n, GLuint *arrays) {}
 
+// Dummy instanced array functions, Hardware::supportsInstancedArrays is not set
+static void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices,
+                                    GLsizei primcount) {}
+static void glVertexAttribDivisor(GLuint index, GLuint divisor) {}
+
 #endif // TANGRAM_RPI
 
+#if defined(TANGRAM_IOS) || defined(TANGRAM_OSX) || defined(TANGRAM_RPI)
+// Dummy program binary functions, a zero length binary is never cached
+static void glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length,
+                               GLenum *binaryFormat, void *binary) { if (length) { *length = 0; } }
+static void glProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {}
+#endif // defined(TANGRAM_IOS) || defined(TANGRAM_OSX) || defined(TANGRAM_RPI)
+
 #if defined(TANGRAM_ANDROID) || defined(TANGRAM_IOS) || defined(TANGRAM_RPI)
     #define glMapBuffer glMapBufferOES
     #define glUnmapBuffer glUnmapBufferOES
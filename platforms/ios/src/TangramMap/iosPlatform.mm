@@ -2,6 +2,7 @@
 #import "TGMapViewController.h"
 #import "TGHttpHandler.h"
 #import "iosPlatform.h"
+#import "gl/hardware.h"
 #import "log.h"
 
 #import <cstdarg>
@@ -27,7 +28,8 @@ void setCurrentThreadPriority(int priority) {
 }
 
 void initGLExtensions() {
-    // No-op
+    Tangram::Hardware::supportsInstancedArrays =
+        Tangram::Hardware::hasExtension("GL_EXT_instanced_arrays");
 }
 
 iOSPlatform::iOSPlatform(__weak TGMapViewController* _viewController) :
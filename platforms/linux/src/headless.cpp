@@ -0,0 +1,231 @@
+#include "linuxPlatform.h"
+#include "log.h"
+#include "map.h"
+#include "miniz.h"
+
+#include <GL/osmesa.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace Tangram;
+
+// Renders map images without a window or GPU, using the OSMesa software
+// renderer. Each thread renders with its own GL context and Map, the maps
+// share the scene config and raw tile data loaded by the first one.
+//
+// Usage: tangram-headless [-f scene.yaml] [-s 512x512] [-j threads] [-o prefix]
+//                         lon,lat,zoom [lon,lat,zoom ...]
+// Writes <prefix><n>.png for the n-th view.
+
+// Maps are drawn by Map::renderOffscreen(), which does not wait for render requests
+class HeadlessPlatform : public LinuxPlatform {
+public:
+    void requestRender() const override {}
+};
+
+struct Viewport {
+    double lon = 0;
+    double lat = 0;
+    float zoom = 0;
+};
+
+struct Options {
+    std::string sceneFile = "scene.yaml";
+    int width = 512;
+    int height = 512;
+    int threads = 2;
+    std::string prefix = "map";
+    std::vector<Viewport> viewports;
+};
+
+// Map::setupGL() loads the process-wide GL hardware flags; threads start
+// rendering only after all of them finished loading
+struct SetupBarrier {
+    std::mutex mutex;
+    std::condition_variable condition;
+    int pending = 0;
+
+    void arrive() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) { condition.notify_all(); }
+    }
+
+    void arriveAndWait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (--pending == 0) { condition.notify_all(); }
+        condition.wait(lock, [&]() { return pending == 0; });
+    }
+};
+
+static bool parseArgs(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "-f") == 0 && hasValue) {
+            options.sceneFile = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 ||
+                options.width <= 0 || options.height <= 0) {
+                LOGE("Invalid size: %s", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "-j") == 0 && hasValue) {
+            options.threads = std::max(atoi(argv[++i]), 1);
+        } else if (strcmp(argv[i], "-o") == 0 && hasValue) {
+            options.prefix = argv[++i];
+        } else {
+            Viewport viewport;
+            if (sscanf(argv[i], "%lf,%lf,%f", &viewport.lon, &viewport.lat, &viewport.zoom) != 3) {
+                LOGE("Invalid view: %s", argv[i]);
+                return false;
+            }
+            options.viewports.push_back(viewport);
+        }
+    }
+    return !options.viewports.empty();
+}
+
+static bool writePng(const std::string& _path, const std::vector<unsigned int>& _pixels,
+                     int _width, int _height) {
+
+    // GL rows start at the bottom of the image
+    size_t size = 0;
+    void* png = tdefl_write_image_to_png_file_in_memory_ex(_pixels.data(), _width, _height, 4,
+                                                           &size, 6, MZ_TRUE);
+    if (!png) { return false; }
+
+    bool ok = false;
+    if (FILE* file = fopen(_path.c_str(), "wb")) {
+        ok = fwrite(png, 1, size, file) == size;
+        fclose(file);
+    }
+    mz_free(png);
+    return ok;
+}
+
+static void renderViewports(std::shared_ptr<Platform> _platform, Map& _sceneMap,
+                            const Options& _options, SetupBarrier& _setup,
+                            std::atomic<size_t>& _next, std::atomic<int>& _failed) {
+
+    OSMesaContext context = OSMesaCreateContextExt(OSMESA_RGBA, 24, 8, 0, nullptr);
+    if (!context) {
+        LOGE("Could not create OSMesa context");
+        _setup.arrive();
+        _failed++;
+        return;
+    }
+
+    // Maps render into their own framebuffer, the context only needs some
+    // default buffer to be current
+    std::vector<unsigned char> contextBuffer(4);
+    if (!OSMesaMakeCurrent(context, contextBuffer.data(), GL_UNSIGNED_BYTE, 1, 1)) {
+        LOGE("Could not make OSMesa context current");
+        OSMesaDestroyContext(context);
+        _setup.arrive();
+        _failed++;
+        return;
+    }
+
+    {
+        Map map(_platform);
+        map.setupGL();
+        _setup.arriveAndWait();
+
+        map.loadSceneFrom(_sceneMap);
+
+        std::vector<unsigned int> pixels;
+
+        for (size_t i = _next++; i < _options.viewports.size(); i = _next++) {
+            auto& viewport = _options.viewports[i];
+            map.setPosition(viewport.lon, viewport.lat);
+            map.setZoom(viewport.zoom);
+
+            auto result = map.renderOffscreen(_options.width, _options.height, pixels);
+
+            std::string path = _options.prefix + std::to_string(i) + ".png";
+            if (result == RenderResult::failed) {
+                LOGE("Could not render %s", path.c_str());
+                _failed++;
+                continue;
+            }
+            if (!writePng(path, pixels, _options.width, _options.height)) {
+                LOGE("Could not write %s", path.c_str());
+                _failed++;
+                continue;
+            }
+            LOG("Wrote %s%s", path.c_str(),
+                result == RenderResult::complete ? "" : " (incomplete)");
+        }
+    }
+
+    OSMesaDestroyContext(context);
+}
+
+int main(int argc, char* argv[]) {
+
+    Options options;
+    if (!parseArgs(argc, argv, options)) {
+        fprintf(stderr, "Usage: %s [-f scene.yaml] [-s WIDTHxHEIGHT] [-j threads] [-o prefix] "
+                "lon,lat,zoom [lon,lat,zoom ...]\n", argv[0]);
+        return 1;
+    }
+
+    auto platform = std::make_shared<HeadlessPlatform>();
+
+    // Resolve the input path against the current directory.
+    Url baseUrl("file:///");
+    char pathBuffer[PATH_MAX] = {0};
+    if (getcwd(pathBuffer, PATH_MAX) != nullptr) {
+        baseUrl = Url(std::string(pathBuffer) + "/").resolved(baseUrl);
+    }
+    Url sceneUrl = Url(options.sceneFile).resolved(baseUrl);
+
+    std::vector<SceneUpdate> updates;
+    if (const char* apiKey = getenv("MAPZEN_API_KEY")) {
+        updates.push_back(SceneUpdate("global.sdk_mapzen_api_key", apiKey));
+    }
+
+    // Imports and parses the scene once for all rendering threads; it is
+    // never rendered itself.
+    Map sceneMap(platform);
+
+    bool loaded = true;
+    sceneMap.setSceneReadyListener([&](SceneID, const SceneError* _error) {
+        if (_error) { loaded = false; }
+    });
+    sceneMap.loadScene(sceneUrl.string(), false, updates);
+
+    if (!loaded) {
+        LOGE("Could not load scene %s", sceneUrl.string().c_str());
+        return 1;
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<int> failed{0};
+
+    int threadCount = std::min<int>(options.threads, options.viewports.size());
+    SetupBarrier setup;
+    setup.pending = threadCount;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(renderViewports, platform, std::ref(sceneMap), std::cref(options),
+                             std::ref(setup), std::ref(next), std::ref(failed));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return failed > 0 ? 1 : 0;
+}
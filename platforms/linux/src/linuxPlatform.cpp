@@ -10,7 +10,7 @@
 #include <sys/resource.h>
 #include <sys/syscall.h>
 
-#if defined(TANGRAM_LINUX)
+#if defined(TANGRAM_LINUX) && !defined(TANGRAM_HEADLESS)
 #include <GLFW/glfw3.h>
 #elif defined(TANGRAM_RPI)
 #include "context.h"
@@ -34,7 +34,10 @@ LinuxPlatform::LinuxPlatform(UrlClient::Options urlClientOptions) :
     m_urlClient(urlClientOptions) {}
 
 void LinuxPlatform::requestRender() const {
+    // The headless renderer has no window to redraw
+#ifndef TANGRAM_HEADLESS
     glfwPostEmptyEvent();
+#endif
 }
 
 std::vector<FontSourceHandle> LinuxPlatform::systemFontFallbacksHandle() const {
@@ -84,6 +87,13 @@ void setCurrentThreadPriority(int priority) {
 
 void initGLExtensions() {
     Tangram::Hardware::supportsMapBuffer = true;
+    Tangram::Hardware::supportsProgramBinary =
+        Tangram::Hardware::hasExtension("GL_ARB_get_program_binary");
+    // The instanced draw functions of GL 3.3 are linked directly, drivers that provide
+    // them to older contexts expose both ARB extensions
+    Tangram::Hardware::supportsInstancedArrays =
+        Tangram::Hardware::hasExtension("GL_ARB_instanced_arrays") &&
+        Tangram::Hardware::hasExtension("GL_ARB_draw_instanced");
 }
 
 } // namespace Tangram
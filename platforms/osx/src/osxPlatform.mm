@@ -27,6 +27,9 @@ void setCurrentThreadPriority(int priority) {
 
 void initGLExtensions() {
     Tangram::Hardware::supportsMapBuffer = true;
+    Tangram::Hardware::supportsInstancedArrays =
+        Tangram::Hardware::hasExtension("GL_ARB_instanced_arrays") &&
+        Tangram::Hardware::hasExtension("GL_ARB_draw_instanced");
 }
 
 void OSXPlatform::requestRender() const {
@@ -272,6 +272,26 @@ void GL::genVertexArrays(GLsizei n, GLuint *arrays) {
     __evas_gl_glapi->glGenVertexArraysOES(n, arrays);
 }
 
+void GL::getProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length,
+                          GLenum *binaryFormat, void *binary) {
+    __evas_gl_glapi->glGetProgramBinaryOES(program, bufSize, length, binaryFormat, binary);
+}
+
+void GL::programBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {
+    __evas_gl_glapi->glProgramBinaryOES(program, binaryFormat, binary, length);
+}
+
+void GL::programParameteri(GLuint program, GLenum pname, GLint value) {}
+
+void GL::drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices,
+                               GLsizei primcount) {
+    __evas_gl_glapi->glDrawElementsInstanced(mode, count, type, indices, primcount);
+}
+
+void GL::vertexAttribDivisor(GLuint index, GLuint divisor) {
+    __evas_gl_glapi->glVertexAttribDivisor(index, divisor);
+}
+
 // Framebuffer
 void GL::bindFramebuffer(GLenum target, GLuint framebuffer) {
     __evas_gl_glapi->glBindFramebuffer(target, framebuffer);
@@ -12,6 +12,7 @@
 #include "platform_gl.h"
 #include "urlWorker.h"
 
+#include "gl/hardware.h"
 #include "log.h"
 
 #include <libgen.h>
@@ -272,4 +273,12 @@ void initGLExtensions() {
      // glBindVertexArrayOESEXT = (PFNGLBINDVERTEXARRAYPROC)glfwGetProcAddress("glBindVertexArray");
      // glDeleteVertexArraysOESEXT = (PFNGLDELETEVERTEXARRAYSPROC)glfwGetProcAddress("glDeleteVertexArrays");
      // glGenVertexArraysOESEXT = (PFNGLGENVERTEXARRAYSPROC)glfwGetProcAddress("glGenVertexArrays");
+
+    Tangram::Hardware::supportsProgramBinary = __evas_gl_glapi &&
+        Tangram::Hardware::hasExtension("GL_OES_get_program_binary") &&
+        __evas_gl_glapi->glGetProgramBinaryOES && __evas_gl_glapi->glProgramBinaryOES;
+
+    // Evas GL leaves the GLES3 functions unset for GLES2 contexts
+    Tangram::Hardware::supportsInstancedArrays = __evas_gl_glapi &&
+        __evas_gl_glapi->glDrawElementsInstanced && __evas_gl_glapi->glVertexAttribDivisor;
 }
@@ -1,226 +1,422 @@
 #include "gl.h"
+#include "gl/glStats.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+
+// GL backend for tests and benchmarks. Nothing is rendered, but calls, state
+// changes and uploads are recorded to GLStats::recorder() and objects get
+// unique handles, so that the render path runs like on a real context.
 
 namespace Tangram {
 
+static GLuint s_nextHandle = 1;
+
+static GLStats& record() {
+    auto& stats = GLStats::recorder();
+    stats.totalCalls++;
+    return stats;
+}
+
+static void genHandles(GLsizei n, GLuint* handles) {
+    for (GLsizei i = 0; i < n; i++) { handles[i] = s_nextHandle++; }
+}
+
+static size_t bytesPerPixel(GLenum format) {
+    switch (format) {
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+        return 1;
+    case GL_LUMINANCE_ALPHA:
+        return 2;
+    case GL_RGB:
+        return 3;
+    default:
+        return 4;
+    }
+}
+
 GLenum GL::getError() {
     return 0;
 }
 
 const GLubyte* GL::getString(GLenum name) {
+    record();
+    if (name == GL_EXTENSIONS) {
+        return reinterpret_cast<const GLubyte*>("");
+    }
     return nullptr;
 }
 
 void GL::clear(GLbitfield mask) {
+    record();
 }
 void GL::lineWidth(GLfloat width) {
+    record().stateChanges++;
 }
 void GL::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    record().stateChanges++;
 }
 
 void GL::enable(GLenum id) {
+    record().stateChanges++;
 }
 void GL::disable(GLenum id) {
+    record().stateChanges++;
 }
 void GL::depthFunc(GLenum func) {
+    record().stateChanges++;
 }
 void GL::depthMask(GLboolean flag) {
+    record().stateChanges++;
 }
 void GL::depthRange(GLfloat n, GLfloat f) {
+    record().stateChanges++;
 }
 void GL::clearDepth(GLfloat d) {
+    record().stateChanges++;
 }
 void GL::blendFunc(GLenum sfactor, GLenum dfactor) {
+    record().stateChanges++;
 }
 void GL::stencilFunc(GLenum func, GLint ref, GLuint mask) {
+    record().stateChanges++;
 }
 void GL::stencilMask(GLuint mask) {
+    record().stateChanges++;
 }
 void GL::stencilOp(GLenum fail, GLenum zfail, GLenum zpass) {
+    record().stateChanges++;
 }
 void GL::clearStencil(GLint s) {
+    record().stateChanges++;
 }
 void GL::colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+    record().stateChanges++;
 }
 void GL::cullFace(GLenum mode) {
+    record().stateChanges++;
 }
 void GL::frontFace(GLenum mode) {
+    record().stateChanges++;
 }
 void GL::clearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha) {
+    record().stateChanges++;
 }
 void GL::getIntegerv(GLenum pname, GLint *params ) {
+    record();
+    switch (pname) {
+    case GL_MAX_TEXTURE_SIZE:
+        *params = 4096;
+        break;
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        *params = 16;
+        break;
+    default:
+        *params = 0;
+    }
 }
 
 // Program
 void GL::useProgram(GLuint program) {
+    record().programBinds++;
 }
 void GL::deleteProgram(GLuint program) {
+    record();
 }
 void GL::deleteShader(GLuint shader) {
+    record();
 }
 GLuint GL::createShader(GLenum type) {
-    return 0;
+    record();
+    return s_nextHandle++;
 }
 GLuint GL::createProgram() {
-    return 0;
+    record();
+    return s_nextHandle++;
 }
 
 void GL::compileShader(GLuint shader) {
+    record();
 }
 void GL::attachShader(GLuint program, GLuint shader) {
+    record();
 }
 void GL::linkProgram(GLuint program) {
+    record();
 }
 
 void GL::shaderSource(GLuint shader, GLsizei count, const GLchar **string, const GLint *length) {
+    record();
 }
 void GL::getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+    record();
 }
 void GL::getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+    record();
 }
 GLint GL::getUniformLocation(GLuint program, const GLchar *name) {
-    return 0;
+    record();
+    // Like a linked program, return the same location for each query of a name
+    static std::map<std::pair<GLuint, std::string>, GLint> locations;
+    auto it = locations.emplace(std::make_pair(program, std::string(name)), 0).first;
+    if (it->second == 0) { it->second = s_nextHandle++; }
+    return it->second;
 }
 GLint GL::getAttribLocation(GLuint program, const GLchar *name) {
+    record();
     return 0;
 }
 void GL::getProgramiv(GLuint program, GLenum pname, GLint *params) {
+    record();
+    switch (pname) {
+    case GL_LINK_STATUS:
+        *params = GL_TRUE;
+        break;
+    case GL_PROGRAM_BINARY_LENGTH:
+        *params = sizeof(GLuint);
+        break;
+    default:
+        *params = 0;
+    }
 }
 void GL::getShaderiv(GLuint shader, GLenum pname, GLint *params) {
+    record();
+    *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
 }
 
 // Buffers
 void GL::bindBuffer(GLenum target, GLuint buffer) {
+    record().bufferBinds++;
 }
 void GL::deleteBuffers(GLsizei n, const GLuint *buffers) {
+    record();
 }
 void GL::genBuffers(GLsizei n, GLuint *buffers) {
+    record();
+    genHandles(n, buffers);
 }
 void GL::bufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    auto& stats = record();
+    stats.bufferUploads++;
+    if (data) { stats.bufferUploadBytes += size; }
 }
 void GL::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    auto& stats = record();
+    stats.bufferUploads++;
+    stats.bufferUploadBytes += size;
 }
 void GL::readPixels(GLint x, GLint y, GLsizei width, GLsizei height,
                     GLenum format, GLenum type, GLvoid* pixels) {
+    record();
 }
 
 // Texture
 void GL::bindTexture(GLenum target, GLuint texture ) {
+    record().textureBinds++;
 }
 void GL::activeTexture(GLenum texture) {
+    record().textureUnitSwitches++;
 }
 void GL::genTextures(GLsizei n, GLuint *textures ) {
+    record();
+    genHandles(n, textures);
 }
 void GL::deleteTextures(GLsizei n, const GLuint *textures) {
+    record();
 }
 void GL::texParameteri(GLenum target, GLenum pname, GLint param ) {
+    record();
 }
 void GL::texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
                     GLint border, GLenum format, GLenum type, const GLvoid *pixels) {
+    auto& stats = record();
+    stats.textureUploads++;
+    if (pixels) { stats.textureUploadBytes += size_t(width) * height * bytesPerPixel(format); }
 }
 void GL::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
                        GLenum format, GLenum type, const GLvoid *pixels) {
+    auto& stats = record();
+    stats.textureUploads++;
+    stats.textureUploadBytes += size_t(width) * height * bytesPerPixel(format);
 }
 void GL::generateMipmap(GLenum target) {
+    record();
 }
 
 void GL::enableVertexAttribArray(GLuint index) {
+    record();
 }
 void GL::disableVertexAttribArray(GLuint index) {
+    record();
 }
 void GL::vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
                              GLsizei stride, const void *pointer) {
+    record();
 }
 
 void GL::drawArrays(GLenum mode, GLint first, GLsizei count ) {
+    auto& stats = record();
+    stats.drawCalls++;
+    stats.drawnVertices += count;
 }
 void GL::drawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices ) {
+    auto& stats = record();
+    stats.drawCalls++;
+    stats.drawnVertices += count;
 }
 
 void GL::uniform1f(GLint location, GLfloat v0) {
+    record().uniformSets++;
 }
 void GL::uniform2f(GLint location, GLfloat v0, GLfloat v1) {
+    record().uniformSets++;
 }
 void GL::uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+    record().uniformSets++;
 }
 void GL::uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    record().uniformSets++;
 }
 
 void GL::uniform1i(GLint location, GLint v0) {
+    record().uniformSets++;
 }
 void GL::uniform2i(GLint location, GLint v0, GLint v1) {
+    record().uniformSets++;
 }
 void GL::uniform3i(GLint location, GLint v0, GLint v1, GLint v2) {
+    record().uniformSets++;
 }
 void GL::uniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+    record().uniformSets++;
 }
 
 void GL::uniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+    record().uniformSets++;
 }
 void GL::uniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+    record().uniformSets++;
 }
 void GL::uniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+    record().uniformSets++;
 }
 void GL::uniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+    record().uniformSets++;
 }
 void GL::uniform1iv(GLint location, GLsizei count, const GLint *value) {
+    record().uniformSets++;
 }
 void GL::uniform2iv(GLint location, GLsizei count, const GLint *value) {
+    record().uniformSets++;
 }
 void GL::uniform3iv(GLint location, GLsizei count, const GLint *value) {
+    record().uniformSets++;
 }
 void GL::uniform4iv(GLint location, GLsizei count, const GLint *value) {
+    record().uniformSets++;
 }
 
 void GL::uniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    record().uniformSets++;
 }
 void GL::uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    record().uniformSets++;
 }
 void GL::uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    record().uniformSets++;
 }
 
 // mapbuffer
 void* GL::mapBuffer(GLenum target, GLenum access) {
+    record();
     return nullptr;
 }
 GLboolean GL::unmapBuffer(GLenum target) {
+    record();
     return true;
 }
 
 void GL::finish(void) {
+    record();
 }
 
 // VAO
 void GL::bindVertexArray(GLuint array) {
+    record().vertexArrayBinds++;
 }
 void GL::deleteVertexArrays(GLsizei n, const GLuint *arrays) {
+    record();
 }
 void GL::genVertexArrays(GLsizei n, GLuint *arrays) {
+    record();
+    genHandles(n, arrays);
+}
+
+// Program binaries
+void GL::getProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length,
+                          GLenum *binaryFormat, void *binary) {
+    record();
+    // The program handle stands in for the driver binary
+    *length = (bufSize >= GLsizei(sizeof(program))) ? sizeof(program) : 0;
+    *binaryFormat = 1;
+    if (*length) { memcpy(binary, &program, sizeof(program)); }
+}
+void GL::programBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {
+    record();
+}
+void GL::programParameteri(GLuint program, GLenum pname, GLint value) {
+    record();
+}
+
+// Instanced arrays
+void GL::drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices,
+                               GLsizei primcount) {
+    auto& stats = record();
+    stats.drawCalls++;
+    stats.drawnVertices += count * primcount;
+}
+void GL::vertexAttribDivisor(GLuint index, GLuint divisor) {
+    record();
 }
 
 // Framebuffer
 void GL::bindFramebuffer(GLenum target, GLuint framebuffer) {
+    record().framebufferBinds++;
 }
 void GL::genFramebuffers(GLsizei n, GLuint *framebuffers) {
+    record();
+    genHandles(n, framebuffers);
 }
 void GL::framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
                               GLuint texture, GLint level) {
+    record();
 }
 void GL::renderbufferStorage(GLenum target, GLenum internalformat, GLsizei width,
                              GLsizei height) {
+    record();
 }
 void GL::framebufferRenderbuffer(GLenum target, GLenum attachment,
                                  GLenum renderbuffertarget, GLuint renderbuffer) {
+    record();
 }
 void GL::genRenderbuffers(GLsizei n, GLuint *renderbuffers) {
+    record();
+    genHandles(n, renderbuffers);
 }
 void GL::bindRenderbuffer(GLenum target, GLuint renderbuffer) {
+    record();
 }
 void GL::deleteFramebuffers(GLsizei n, const GLuint *framebuffers) {
+    record();
 }
 void GL::deleteRenderbuffers(GLsizei n, const GLuint *renderbuffers) {
+    record();
 }
 GLenum GL::checkFramebufferStatus(GLenum target) {
-    return 0;
+    record();
+    return GL_FRAMEBUFFER_COMPLETE;
 }
 
 }
@@ -0,0 +1,36 @@
+#include "catch.hpp"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "util/geom.h"
+
+using namespace Tangram;
+
+TEST_CASE("Boxes inside or crossing the clip volume are not culled", "[Culling][core]") {
+    glm::mat4 mvp(1.0);
+
+    CHECK_FALSE(isBoxOutsideClipSpace(mvp, {-0.5, -0.5, 0.0}, {0.5, 0.5, 0.0}));
+    // Larger than the clip volume
+    CHECK_FALSE(isBoxOutsideClipSpace(mvp, {-4.0, -4.0, 0.0}, {4.0, 4.0, 0.0}));
+    // Crossing the right side
+    CHECK_FALSE(isBoxOutsideClipSpace(mvp, {0.5, -0.5, 0.0}, {2.0, 0.5, 0.0}));
+}
+
+TEST_CASE("Boxes outside of one side of the clip volume are culled", "[Culling][core]") {
+    glm::mat4 mvp(1.0);
+
+    CHECK(isBoxOutsideClipSpace(mvp, {2.0, -0.5, 0.0}, {3.0, 0.5, 0.0}));
+    CHECK(isBoxOutsideClipSpace(mvp, {-3.0, -0.5, 0.0}, {-2.0, 0.5, 0.0}));
+    CHECK(isBoxOutsideClipSpace(mvp, {-0.5, 2.0, 0.0}, {0.5, 3.0, 0.0}));
+    // Above the top side, across the full width
+    CHECK(isBoxOutsideClipSpace(mvp, {-3.0, 2.0, 0.0}, {3.0, 3.0, 0.0}));
+}
+
+TEST_CASE("Boxes behind the camera are culled", "[Culling][core]") {
+    auto proj = glm::perspective(1.0f, 1.0f, 0.1f, 100.0f);
+    auto view = glm::lookAt(glm::vec3(0, 0, 10), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+    auto mvp = proj * view;
+
+    CHECK_FALSE(isBoxOutsideClipSpace(mvp, {-1.0, -1.0, 0.0}, {1.0, 1.0, 1.0}));
+    CHECK(isBoxOutsideClipSpace(mvp, {-1.0, -1.0, 20.0}, {1.0, 1.0, 30.0}));
+}
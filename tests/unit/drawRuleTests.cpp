@@ -2,6 +2,8 @@
 
 #include "scene/drawRule.h"
 #include "scene/sceneLayer.h"
+#include "scene/stops.h"
+#include "scene/styleContext.h"
 #include "platform.h"
 
 #include <cstdio>
@@ -205,3 +207,78 @@ TEST_CASE("DrawRule correctly reports that it doesn't contain a parameter", "[Dr
 
 
 }
+
+TEST_CASE("DrawRule evaluates Stops from the values cached per zoom", "[DrawRule]") {
+
+    Stops widths({ Stops::Frame(10, 1.f), Stops::Frame(16, 4.f) });
+    Stops colors({ Stops::Frame(0, Color(0xff000000)), Stops::Frame(20, Color(0xffffffff)) });
+
+    std::vector<StyleParam> params = {
+        { StyleParamKey::width, &widths },
+        { StyleParamKey::color, &colors },
+        { StyleParamKey::cap, "round" }
+    };
+    const SceneLayer layer = { "a", Filter(), { { "dg1", dg1, std::move(params) } }, {}, true };
+    const auto& ruleData = layer.rules()[0];
+
+    REQUIRE(ruleData.zoomParams(0) != nullptr);
+    REQUIRE(ruleData.zoomParams(1) != nullptr);
+    REQUIRE(ruleData.zoomParams(2) == nullptr);
+
+    StyleContext ctx;
+
+    for (int zoom : { 0, 10, 13, 16, 20, DrawRuleData::maxCachedZoom, DrawRuleData::maxCachedZoom + 1 }) {
+        ctx.setKeywordZoom(zoom);
+
+        DrawRuleMergeSet ruleSet;
+        ruleSet.mergeRules(layer);
+        auto& rule = ruleSet.matchedRules()[0];
+        REQUIRE(ruleSet.evaluateRuleForContext(rule, ctx));
+
+        float width = 0;
+        uint32_t color = 0;
+        REQUIRE(rule.get(StyleParamKey::width, width));
+        REQUIRE(rule.get(StyleParamKey::color, color));
+        CHECK(width == widths.evalExpFloat(zoom));
+        CHECK(color == colors.evalColor(zoom));
+
+        std::string cap;
+        REQUIRE(rule.get(StyleParamKey::cap, cap));
+        CHECK(cap == "round");
+
+        // Points to the cached value instead of evaluating the Stops for each feature
+        bool cached = zoom <= DrawRuleData::maxCachedZoom;
+        CHECK((&rule.findParameter(StyleParamKey::width) == &ruleData.zoomParams(0)[zoom]) == cached);
+    }
+}
+
+TEST_CASE("DrawRuleMergeSet merges rules by id after its matched rules were cleared", "[DrawRule]") {
+
+    std::string str;
+
+    const SceneLayer layer_a = { "a", Filter(), { instance_a() }, {}, true };
+    const SceneLayer layer_b = { "b", Filter(), { instance_b() }, {}, true };
+    const SceneLayer layer_d = { "d", Filter(), { { "dg2", dg2, { { StyleParamKey::order, "value_0d" } } } }, {}, true };
+
+    DrawRuleMergeSet ruleSet;
+    ruleSet.mergeRules(layer_d);
+    ruleSet.mergeRules(layer_a);
+    REQUIRE(ruleSet.matchedRules().size() == 2);
+
+    ruleSet.matchedRules().clear();
+
+    // The rule of layer_a was at the second position before
+    ruleSet.mergeRules(layer_a);
+    ruleSet.mergeRules(layer_b);
+    ruleSet.mergeRules(layer_d);
+    REQUIRE(ruleSet.matchedRules().size() == 2);
+
+    auto& rule_ab = ruleSet.matchedRules()[0];
+    REQUIRE(rule_ab.id == dg1);
+    REQUIRE(rule_ab.get(StyleParamKey::order, str)); REQUIRE(str == "value_0b");
+    REQUIRE(rule_ab.get(StyleParamKey::join, str)); REQUIRE(str == "value_4a");
+
+    auto& rule_d = ruleSet.matchedRules()[1];
+    REQUIRE(rule_d.id == dg2);
+    REQUIRE(rule_d.get(StyleParamKey::order, str)); REQUIRE(str == "value_0d");
+}
@@ -0,0 +1,107 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "text/glyphCache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Tangram;
+
+static const std::string cachePath = "./glyphCacheTest.bin";
+
+static std::vector<unsigned char> glyph(uint16_t _width, uint16_t _height, unsigned char _seed) {
+    std::vector<unsigned char> data(size_t(_width) * _height);
+    for (size_t i = 0; i < data.size(); i++) { data[i] = _seed + i; }
+    return data;
+}
+
+static void writeCache() {
+    std::remove(cachePath.c_str());
+
+    GlyphCache cache;
+    REQUIRE_FALSE(cache.load(cachePath));
+
+    auto a = glyph(4, 3, 1);
+    auto b = glyph(5, 2, 7);
+    cache.put(1, 4, 3, a.data(), 4);
+    cache.put(2, 5, 2, b.data(), 5);
+    REQUIRE(cache.save());
+}
+
+TEST_CASE("Glyphs put into the glyph cache are loaded from its file", "[GlyphCache][core]") {
+    writeCache();
+
+    GlyphCache cache;
+    REQUIRE(cache.load(cachePath));
+    CHECK(cache.size() == 2);
+
+    // Rows of the destination are further apart than the glyph width
+    std::vector<unsigned char> dst(8 * 3);
+    REQUIRE(cache.get(1, 4, 3, dst.data(), 8));
+    auto a = glyph(4, 3, 1);
+    for (size_t y = 0; y < 3; y++) {
+        CHECK(std::equal(a.begin() + y * 4, a.begin() + (y + 1) * 4, dst.begin() + y * 8));
+    }
+
+    // Sizes must match the cached entry
+    CHECK_FALSE(cache.get(2, 4, 3, dst.data(), 8));
+    CHECK_FALSE(cache.get(3, 4, 3, dst.data(), 8));
+
+    std::remove(cachePath.c_str());
+}
+
+TEST_CASE("Truncated glyph cache files are rejected", "[GlyphCache][core]") {
+    writeCache();
+
+    std::vector<char> contents;
+    {
+        std::ifstream file(cachePath, std::ifstream::binary);
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    REQUIRE(contents.size() > 4);
+    {
+        std::ofstream file(cachePath, std::ofstream::binary | std::ofstream::trunc);
+        file.write(contents.data(), contents.size() - 4);
+    }
+
+    GlyphCache cache;
+    CHECK_FALSE(cache.load(cachePath));
+    CHECK(cache.size() == 0);
+
+    std::remove(cachePath.c_str());
+}
+
+TEST_CASE("Glyph cache files of another format are rejected", "[GlyphCache][core]") {
+    {
+        std::ofstream file(cachePath, std::ofstream::binary | std::ofstream::trunc);
+        file << "not a glyph cache, but long enough for a header";
+    }
+
+    GlyphCache cache;
+    CHECK_FALSE(cache.load(cachePath));
+    CHECK(cache.size() == 0);
+
+    std::remove(cachePath.c_str());
+}
+
+TEST_CASE("Glyph caches opened for the same file are shared", "[GlyphCache][core]") {
+    writeCache();
+
+    auto first = GlyphCache::open(cachePath);
+    auto second = GlyphCache::open(cachePath);
+    CHECK(first == second);
+
+    // Glyphs put before the background load finished are saved with the loaded ones
+    auto c = glyph(2, 2, 3);
+    first->put(3, 2, 2, c.data(), 2);
+    REQUIRE(second->save());
+
+    GlyphCache cache;
+    REQUIRE(cache.load(cachePath));
+    CHECK(cache.size() == 3);
+
+    std::remove(cachePath.c_str());
+}
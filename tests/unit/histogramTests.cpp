@@ -0,0 +1,60 @@
+#include "catch.hpp"
+
+#include "util/histogram.h"
+
+#include <thread>
+#include <vector>
+
+using namespace Tangram;
+
+TEST_CASE("Histogram records values into doubling buckets", "[Histogram]") {
+    Histogram histogram;
+
+    CHECK(histogram.count() == 0);
+    CHECK(histogram.percentile(0.5f) == 0.f);
+
+    CHECK(Histogram::bucketLimit(0) == 0.25f);
+    CHECK(Histogram::bucketLimit(3) == 2.f);
+
+    histogram.record(0.1f);
+    histogram.record(1.5f);
+    histogram.record(1.8f);
+    histogram.record(100.f);
+
+    CHECK(histogram.count() == 4);
+    CHECK(histogram.bucket(0) == 1);
+    CHECK(histogram.bucket(3) == 2);
+    CHECK(histogram.mean() == Approx(25.85f));
+    CHECK(histogram.max() == 100.f);
+
+    CHECK(histogram.percentile(0.25f) == 0.25f);
+    CHECK(histogram.percentile(0.5f) == 2.f);
+    CHECK(histogram.percentile(0.75f) == 2.f);
+    CHECK(histogram.percentile(1.f) == 100.f);
+
+    // Values beyond the last limit go into the last bucket
+    histogram.record(1e9f);
+    CHECK(histogram.bucket(Histogram::bucketCount - 1) == 1);
+    CHECK(histogram.percentile(1.f) == 1e9f);
+
+    histogram.reset();
+    CHECK(histogram.count() == 0);
+    CHECK(histogram.bucket(3) == 0);
+    CHECK(histogram.max() == 0.f);
+}
+
+TEST_CASE("Histogram counts values recorded from several threads", "[Histogram]") {
+    Histogram histogram;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 1000; i++) { histogram.record(1.f); }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    CHECK(histogram.count() == 4000);
+    CHECK(histogram.bucket(2) == 4000);
+    CHECK(histogram.mean() == Approx(1.f));
+}
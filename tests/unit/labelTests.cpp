@@ -5,6 +5,8 @@
 #include "labels/textLabels.h"
 #include "map.h"
 #include "style/textStyle.h"
+#include "util/batchProjection.h"
+#include "util/geom.h"
 #include "view/view.h"
 
 #include "glm/mat4x4.hpp"
@@ -41,6 +43,15 @@ TextLabel makeLabel(glm::vec2 _transform, Label::Type _type) {
             TextLabelProperty::Align::none);
 }
 
+bool updateLabel(Label& _label, const glm::mat4& _mvp, const ViewState& _viewState,
+                 ScreenTransform& _transform) {
+    BatchProjection projection;
+    _label.addProjectionPoints(_viewState, projection);
+    projection.project(_mvp, _viewState.viewportSize);
+
+    return _label.update(projection, _viewState, &bounds, _transform);
+}
+
 View makeView() {
     View view(256, 256);
 
@@ -58,13 +69,13 @@ TEST_CASE( "Ensure the transition from wait -> sleep when occlusion happens", "[
     TextLabel l(makeLabel({screenSize/2.f}, Label::Type::point));
 
     REQUIRE(l.state() == Label::State::none);
-    l.update(glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), &bounds, t1.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), t1.transform);
 
     REQUIRE(l.state() != Label::State::sleep);
     REQUIRE(l.state() == Label::State::none);
     REQUIRE(l.canOcclude());
 
-    l.update(glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), &bounds, t2.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), t2.transform);
     l.occlude(true);
     l.evalState(0);
 
@@ -79,14 +90,14 @@ TEST_CASE( "Ensure the transition from wait -> visible when no occlusion happens
 
     REQUIRE(l.state() == Label::State::none);
 
-    l.update(glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), &bounds, t1.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), t1.transform);
     l.occlude(false);
     l.evalState(0);
 
     REQUIRE(l.state() == Label::State::fading_in);
     REQUIRE(l.canOcclude());
 
-    l.update(glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), &bounds, t2.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), t2.transform);
     l.evalState(1.f);
 
     REQUIRE(l.state() == Label::State::visible);
@@ -99,14 +110,14 @@ TEST_CASE( "Ensure the end state after occlusion is leep state", "[Core][Label]"
 
     TextLabel l(makeLabel({screenSize/2.f}, Label::Type::point));
 
-    l.update(glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), &bounds, t1.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), t1.transform);
     l.occlude(false);
     l.evalState(0);
 
     REQUIRE(l.state() == Label::State::fading_in);
     REQUIRE(l.canOcclude());
 
-    l.update(glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), &bounds, t2.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), t2.transform);
     l.occlude(true);
     l.evalState(1.f);
 
@@ -122,12 +133,12 @@ TEST_CASE( "Ensure the sleep transition for out of screen labels", "[Core][Label
 
     REQUIRE(l.state() == Label::State::none);
 
-    l.update(glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), &bounds, t1.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), t1.transform);
 
     REQUIRE(l.state() == Label::State::sleep);
     REQUIRE(l.canOcclude());
 
-    l.update(glm::ortho(0.f, screenSize.x * 4.f, screenSize.y * 4.f, 0.f, -1.f, 1.f), view.state(), &bounds, t2.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x * 4.f, screenSize.y * 4.f, 0.f, -1.f, 1.f), view.state(), t2.transform);
     l.evalState(0);
     REQUIRE(l.state() != Label::State::none);
 
@@ -144,7 +155,7 @@ TEST_CASE( "Ensure debug labels are always visible and cannot occlude", "[Core][
     REQUIRE(!l.canOcclude());
 
     TestTransform t1;
-    l.update(glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), &bounds, t1.transform);
+    updateLabel(l, glm::ortho(0.f, screenSize.x, screenSize.y, 0.f, -1.f, 1.f), view.state(), t1.transform);
     l.evalState(1.f);
 
     REQUIRE(l.state() == Label::State::visible);
@@ -214,3 +225,36 @@ TEST_CASE( "Sine interpolation", "[Core][Label][Fade]" ) {
 
     REQUIRE(fadeIn.isFinished());
 }
+
+TEST_CASE( "Batch projection matches per-point projection", "[Core][Label][Projection]" ) {
+    View view = makeView();
+    view.setPitch(0.5f);
+    view.update(false);
+
+    glm::mat4 mvp = view.getViewProjectionMatrix();
+
+    BatchProjection projection;
+    std::vector<glm::vec2> points;
+
+    // Use a count that is not a multiple of the SIMD width
+    for (int i = 0; i < 23; i++) {
+        points.emplace_back(i * 1000.f - 11000.f, i * 700.f - 8000.f);
+        projection.add(points.back());
+    }
+
+    projection.project(mvp, screenSize);
+
+    for (size_t i = 0; i < points.size(); i++) {
+        glm::vec4 clip = mvp * glm::vec4(points[i], 0.f, 1.f);
+
+        REQUIRE(projection.clipped(i) == (clip.w <= 0.f));
+        if (projection.clipped(i)) { continue; }
+
+        glm::vec2 expected = clipToScreenSpace(clip, screenSize);
+        glm::vec2 position = projection.screenPosition(i);
+
+        REQUIRE(std::fabs(position.x - expected.x) < 0.01);
+        REQUIRE(std::fabs(position.y - expected.y) < 0.01);
+        REQUIRE(std::fabs(projection.ndc(i).z - clip.z / clip.w) < EPSILON);
+    }
+}
@@ -9,6 +9,7 @@
 #include "style/style.h"
 #include "style/textStyle.h"
 #include "tile/tile.h"
+#include "util/batchProjection.h"
 #include "view/view.h"
 
 #include <memory>
@@ -19,6 +20,15 @@ TextStyle dummyStyle("textStyle", nullptr);
 TextLabels dummy(dummyStyle);
 Label::AABB* bounds = nullptr;
 
+bool updateLabel(Label& _label, const glm::mat4& _mvp, const ViewState& _viewState,
+                 ScreenTransform& _transform) {
+    BatchProjection projection;
+    _label.addProjectionPoints(_viewState, projection);
+    projection.project(_mvp, _viewState.viewportSize);
+
+    return _label.update(projection, _viewState, bounds, _transform);
+}
+
 std::unique_ptr<TextLabel> makeLabel(glm::vec2 _transform, Label::Type _type, std::string id) {
     Label::Options options;
     options.offset = {0.0f, 0.0f};
@@ -138,11 +148,11 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
         TestLabels labels(view);
         TextLabel l1 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5});
         auto& t1 = labels.addLabel(&l1, &tile);
-        l1.update(tile.mvp(), view.state(), bounds, t1);
+        updateLabel(l1, tile.mvp(), view.state(), t1);
 
         TextLabel l2 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5});
         auto& t2 = labels.addLabel(&l2, &tile);
-        l2.update(tile.mvp(), view.state(), bounds, t2);
+        updateLabel(l2, tile.mvp(), view.state(), t2);
 
         labels.run(view);
         REQUIRE(l1.isOccluded() == false);
@@ -156,12 +166,12 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
         TestLabels labels(view);
         TextLabel l1 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5});
         auto& t1 = labels.addLabel(&l1, &tile);
-        l1.update(tile.mvp(), view.state(), bounds, t1);
+        updateLabel(l1, tile.mvp(), view.state(), t1);
 
         // Second label is one pixel left of L1
         TextLabel l2 = makeLabelWithAnchorFallbacks(glm::vec2{0.5 - 1./256,0.5});
         auto& t2 = labels.addLabel(&l2, &tile);
-        l2.update(tile.mvp(), view.state(), bounds, t2);
+        updateLabel(l2, tile.mvp(), view.state(), t2);
 
         labels.run(view);
         // l1.print();
@@ -178,12 +188,12 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
         TestLabels labels(view);
         TextLabel l1 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5});
         auto& t1 = labels.addLabel(&l1, &tile);
-        l1.update(tile.mvp(), view.state(), bounds, t1);
+        updateLabel(l1, tile.mvp(), view.state(), t1);
 
         // Second label is 10 pixel top of L1
         TextLabel l2 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5 + 10./256});
         auto& t2 = labels.addLabel(&l2, &tile);
-        l2.update(tile.mvp(), view.state(), bounds, t2);
+        updateLabel(l2, tile.mvp(), view.state(), t2);
 
         labels.run(view);
         REQUIRE(l1.isOccluded() == false);
@@ -198,12 +208,12 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
         TestLabels labels(view);
         TextLabel l1 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5});
         auto& t1 = labels.addLabel(&l1, &tile);
-        l1.update(tile.mvp(), view.state(), bounds, t1);
+        updateLabel(l1, tile.mvp(), view.state(), t1);
 
         // Second label is 10 pixel below of L1
         TextLabel l2 = makeLabelWithAnchorFallbacks(glm::vec2{0.5,0.5 - 10./256});
         auto& t2 = labels.addLabel(&l2, &tile);
-        l2.update(tile.mvp(), view.state(), bounds, t2);
+        updateLabel(l2, tile.mvp(), view.state(), t2);
 
         labels.run(view);
         REQUIRE(l1.isOccluded() == false);
@@ -215,4 +225,37 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
     }
 
 }
+TEST_CASE( "Spatial hash finds labels of the same repeat group within distance", "[Labels][RepeatGroup]" ) {
+
+    SpatialHash<int> grid;
+
+    grid.addQueryRadius(1, 100);
+    grid.addQueryRadius(2, 50);
+
+    grid.insert(1, {10, 10}, 1);
+    grid.insert(1, {200, 10}, 2);
+    grid.insert(2, {12, 10}, 3);
+
+    std::vector<int> found;
+    grid.query(1, {40, 10}, 100, [&](int item) { found.push_back(item); return false; });
+
+    REQUIRE(found.size() == 1);
+    REQUIRE(found[0] == 1);
+
+    // Items of other groups are never matched
+    REQUIRE(!grid.query(2, {-60, 10}, 50, [](int) { return true; }));
+    REQUIRE(grid.query(2, {-30, 10}, 50, [](int) { return true; }));
+
+    grid.clear();
+    REQUIRE(grid.empty());
+    REQUIRE(!grid.query(1, {10, 10}, 100, [](int) { return true; }));
+
+    // Cells are reused after clear(), with the cell size of the new radius
+    grid.addQueryRadius(1, 1000);
+    grid.insert(1, {900, 10}, 4);
+    REQUIRE(!grid.empty());
+    REQUIRE(grid.query(1, {10, 10}, 1000, [](int item) { return item == 4; }));
+    REQUIRE(!grid.query(1, {10, 10}, 100, [](int) { return true; }));
+}
+
 }
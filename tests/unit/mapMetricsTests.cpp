@@ -0,0 +1,69 @@
+#include "catch.hpp"
+
+#include "map.h"
+#include "mockPlatform.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace Tangram;
+
+static const char* sceneYaml = R"END(
+scene:
+    background:
+        color: '#f0ebeb'
+)END";
+
+static void renderFrames(Map& _map, int _frames) {
+    for (int i = 0; i < _frames; i++) {
+        _map.update(1.f / 60.f);
+        _map.render();
+    }
+}
+
+TEST_CASE("Map metrics count frames until they are reset", "[Metrics]") {
+    auto platform = std::make_shared<MockPlatform>();
+    Map map(platform);
+
+    map.setupGL();
+    map.resize(800, 600);
+    map.loadSceneYaml(sceneYaml, "");
+
+    map.setPosition(-74.00, 40.70);
+    map.setZoom(14.f);
+
+    // Updates are skipped until the fonts of the scene are loaded
+    for (int i = 0; i < 100 && map.getMetrics().frameUpdate.count == 0; i++) {
+        renderFrames(map, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(map.getMetrics().frameUpdate.count > 0);
+
+    map.resetMetrics();
+
+    auto reset = map.getMetrics();
+    CHECK(reset.frameUpdate.count == 0);
+    CHECK(reset.frameRender.count == 0);
+    CHECK(reset.tileCacheHits == 0);
+    CHECK(reset.tileCacheMisses == 0);
+
+    renderFrames(map, 3);
+
+    auto metrics = map.getMetrics();
+    CHECK(metrics.frameUpdate.count == 3);
+    CHECK(metrics.frameRender.count == 3);
+
+    // A scene without sources has no tiles and no raw tile caches
+    CHECK(metrics.tilesVisible == 0);
+    CHECK(metrics.tileCacheEntries == 0);
+    CHECK(metrics.rawCacheBytes == 0);
+    CHECK(metrics.rawCacheHits == 0);
+    CHECK(metrics.rawCacheMisses == 0);
+
+    map.resetMetrics();
+
+    auto next = map.getMetrics();
+    CHECK(next.frameUpdate.count == 0);
+    CHECK(next.frameRender.count == 0);
+    CHECK(next.frameUpdate.max == 0);
+}
@@ -0,0 +1,149 @@
+#include "catch.hpp"
+
+#include "data/memoryCacheDataSource.h"
+#include "data/tileSource.h"
+#include "tile/tileID.h"
+#include "tile/tileTask.h"
+
+#include <memory>
+#include <vector>
+
+using namespace Tangram;
+
+// Returns data for every tile and counts the requests
+struct CountingDataSource : TileSource::DataSource {
+    int loads = 0;
+
+    bool loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+        loads++;
+        auto& task = static_cast<BinaryTileTask&>(*_task);
+        task.rawTileData = std::make_shared<std::vector<char>>(16, 'x');
+        _cb.func(_task);
+        return true;
+    }
+};
+
+struct CacheChain {
+    MemoryCacheDataSource cache;
+    CountingDataSource* counter;
+
+    CacheChain() {
+        auto next = std::make_unique<CountingDataSource>();
+        counter = next.get();
+        cache.setCacheSize(1 << 20);
+        cache.setNext(std::move(next));
+    }
+
+    bool load(TileID _tileId, std::shared_ptr<TileSource> _source) {
+        auto task = std::make_shared<BinaryTileTask>(_tileId, _source, -1);
+        cache.loadTileData(task, {[](std::shared_ptr<TileTask>) {}});
+        return task->hasData();
+    }
+};
+
+TEST_CASE("MemoryCacheDataSource loads each tile once", "[MemoryCache]") {
+    auto source = std::make_shared<TileSource>("test", nullptr);
+    CacheChain chain;
+
+    REQUIRE(chain.load({1, 2, 3}, source));
+    REQUIRE(chain.load({1, 2, 3}, source));
+    CHECK(chain.counter->loads == 1);
+
+    REQUIRE(chain.load({2, 2, 3}, source));
+    CHECK(chain.counter->loads == 2);
+}
+
+TEST_CASE("MemoryCacheDataSources with a shared cache load each tile once", "[MemoryCache]") {
+    auto source = std::make_shared<TileSource>("test", nullptr);
+    CacheChain a, b;
+
+    b.cache.shareCache(a.cache);
+
+    REQUIRE(a.load({1, 2, 3}, source));
+    REQUIRE(b.load({1, 2, 3}, source));
+    CHECK(a.counter->loads == 1);
+    CHECK(b.counter->loads == 0);
+
+    REQUIRE(b.load({2, 2, 3}, source));
+    REQUIRE(a.load({2, 2, 3}, source));
+    CHECK(a.counter->loads == 1);
+    CHECK(b.counter->loads == 1);
+
+    // Clearing either source clears the shared cache
+    b.cache.clear();
+    REQUIRE(a.load({1, 2, 3}, source));
+    CHECK(a.counter->loads == 2);
+}
+
+TEST_CASE("MemoryCacheDataSources count hits and misses of their own cache", "[MemoryCache]") {
+    auto source = std::make_shared<TileSource>("test", nullptr);
+    CacheChain a, b;
+
+    REQUIRE(a.load({1, 2, 3}, source));
+    REQUIRE(a.load({1, 2, 3}, source));
+    REQUIRE(b.load({1, 2, 3}, source));
+
+    TileSource::CacheStats statsA, statsB;
+    a.cache.cacheStats(statsA);
+    b.cache.cacheStats(statsB);
+    CHECK(statsA.hits == 1);
+    CHECK(statsA.misses == 1);
+    CHECK(statsA.bytes == 16);
+    CHECK(statsB.hits == 0);
+    CHECK(statsB.misses == 1);
+
+    a.cache.resetCacheStats();
+    TileSource::CacheStats reset;
+    a.cache.cacheStats(reset);
+    CHECK(reset.hits == 0);
+    CHECK(reset.misses == 0);
+    CHECK(reset.bytes == 16);
+}
+
+TEST_CASE("TileSources sum the cache counters of their data sources", "[MemoryCache]") {
+    auto first = std::make_unique<MemoryCacheDataSource>();
+    auto second = std::make_unique<MemoryCacheDataSource>();
+    auto counter = std::make_unique<CountingDataSource>();
+
+    first->setCacheSize(1 << 20);
+    second->setCacheSize(1 << 20);
+    second->setNext(std::move(counter));
+    first->setNext(std::move(second));
+
+    auto source = std::make_shared<TileSource>("test", std::move(first));
+
+    auto load = [&](TileID _tileId) {
+        auto task = std::make_shared<BinaryTileTask>(_tileId, source, -1);
+        source->loadTileData(task, {[](std::shared_ptr<TileTask>) {}});
+        return task->hasData();
+    };
+
+    REQUIRE(load({1, 2, 3}));
+    REQUIRE(load({1, 2, 3}));
+    REQUIRE(load({2, 2, 3}));
+
+    // The first cache misses twice and hits once, the second one only
+    // sees the misses of the first and stores the same tiles
+    TileSource::CacheStats stats;
+    source->cacheStats(stats);
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 4);
+    CHECK(stats.bytes == 64);
+
+    // Clearing drops the tiles of both caches but keeps the counters
+    source->clearData();
+    REQUIRE(load({1, 2, 3}));
+
+    TileSource::CacheStats cleared;
+    source->cacheStats(cleared);
+    CHECK(cleared.hits == 1);
+    CHECK(cleared.misses == 6);
+    CHECK(cleared.bytes == 32);
+
+    source->resetCacheStats();
+    TileSource::CacheStats reset;
+    source->cacheStats(reset);
+    CHECK(reset.hits == 0);
+    CHECK(reset.misses == 0);
+    CHECK(reset.bytes == 32);
+}
@@ -1,7 +1,12 @@
 #include "catch.hpp"
 
 #include <iostream>
+#include "gl/dynamicQuadMesh.h"
+#include "gl/glStats.h"
+#include "gl/instancedQuadMesh.h"
 #include "gl/mesh.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
 
 using namespace Tangram;
 
@@ -170,3 +175,118 @@ TEST_CASE( "Check overflow", "[Core][TypedMesh]" ) {
 
     checkBounds(mesh);
 }
+
+struct SelectableVertex {
+    float x;
+    float y;
+    GLuint selection;
+};
+
+std::shared_ptr<VertexLayout> selectableLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+    {"a_position", 2, GL_FLOAT, false, 0},
+    {"a_selection_color", 4, GL_UNSIGNED_BYTE, true, 0},
+}));
+
+std::shared_ptr<Mesh<SelectableVertex>> newSelectableMesh(GLuint _selection) {
+    auto mesh = std::make_shared<Mesh<SelectableVertex>>(selectableLayout, GL_TRIANGLES);
+    MeshData<SelectableVertex> meshData;
+    meshData.vertices = {{1.f, 2.f, 0}, {3.f, 4.f, _selection}};
+    meshData.offsets.emplace_back(0, 2);
+    mesh->compile(meshData);
+    return mesh;
+}
+
+TEST_CASE( "Attributes that are zero in all vertices are dropped", "[Core][TypedMesh]" ) {
+    auto mesh = newSelectableMesh(0);
+
+    REQUIRE(mesh->isSelectable());
+    REQUIRE(mesh->dropZeroAttrib("a_selection_color"));
+    REQUIRE(!mesh->isSelectable());
+    REQUIRE(mesh->bufferSize() == 2 * 2 * sizeof(float));
+
+    // Updates are ignored once the vertex data does not match the vertex type
+    mesh->updateVertices({0, 1}, SelectableVertex{5.f, 6.f, 1});
+    REQUIRE(mesh->bufferSize() == 2 * 2 * sizeof(float));
+
+    // Meshes share the reduced layout
+    REQUIRE(selectableLayout->without("a_selection_color") ==
+            selectableLayout->without("a_selection_color"));
+}
+
+TEST_CASE( "Attributes with non-zero values are kept", "[Core][TypedMesh]" ) {
+    auto mesh = newSelectableMesh(0xff0000ff);
+
+    REQUIRE(!mesh->dropZeroAttrib("a_selection_color"));
+    REQUIRE(!mesh->dropZeroAttrib("a_unknown"));
+    REQUIRE(mesh->isSelectable());
+    REQUIRE(mesh->bufferSize() == 2 * sizeof(SelectableVertex));
+}
+
+TEST_CASE( "Instanced quads upload one record per quad", "[Core][InstancedQuadMesh]" ) {
+    RenderState rs;
+    ShaderProgram program;
+    program.setShaderSource("void main() {}\n", "void main() {}\n");
+
+    auto instanceLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 2, GL_FLOAT, false, 0},
+    }));
+
+    InstancedQuadMesh<glm::vec2> mesh(instanceLayout, GL_TRIANGLES);
+    for (int i = 0; i < 3; i++) {
+        *mesh.pushInstance() = glm::vec2(i);
+    }
+    REQUIRE(mesh.numberOfInstances() == 3);
+
+    auto& stats = GLStats::recorder();
+    stats.reset();
+
+    mesh.upload(rs);
+    REQUIRE(stats.bufferUploadBytes == 3 * sizeof(glm::vec2));
+
+    stats.reset();
+
+    REQUIRE(mesh.drawRange(rs, program, 1, 2));
+    REQUIRE(stats.drawCalls == 1);
+    REQUIRE(stats.drawnVertices == 2 * 6);
+
+    // Out of range
+    REQUIRE(!mesh.drawRange(rs, program, 2, 2));
+
+    mesh.clear();
+    REQUIRE(mesh.numberOfInstances() == 0);
+    REQUIRE(!mesh.draw(rs, program));
+}
+
+TEST_CASE( "Dynamic quads upload only the vertices that changed", "[Core][DynamicQuadMesh]" ) {
+    RenderState rs;
+    DynamicQuadMesh<SelectableVertex> mesh(selectableLayout, GL_TRIANGLES);
+
+    auto pushQuads = [&](GLuint _selection) {
+        mesh.clear();
+        for (int i = 0; i < 4; i++) {
+            auto* quad = mesh.pushQuad();
+            for (int j = 0; j < 4; j++) { quad[j] = {float(i), float(j), 0}; }
+        }
+        // Change the last vertex
+        mesh.pushQuad()[3].selection = _selection;
+    };
+
+    auto& stats = GLStats::recorder();
+
+    pushQuads(0);
+    stats.reset();
+    mesh.upload(rs);
+    REQUIRE(stats.bufferUploadBytes == 5 * 4 * sizeof(SelectableVertex));
+
+    // Same vertices as in the buffer
+    pushQuads(0);
+    stats.reset();
+    mesh.upload(rs);
+    REQUIRE(stats.bufferUploads == 0);
+
+    pushQuads(1);
+    stats.reset();
+    mesh.upload(rs);
+    REQUIRE(stats.bufferUploadBytes == sizeof(SelectableVertex));
+    REQUIRE(mesh.numberOfVertices() == 5 * 4);
+}
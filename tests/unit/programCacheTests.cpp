@@ -0,0 +1,105 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "gl/hardware.h"
+#include "gl/programCache.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace Tangram;
+
+static const std::string vertSrc = "void main() { gl_Position = vec4(0.0); }\n";
+static const std::string fragSrc = "void main() { gl_FragColor = vec4(1.0); }\n";
+
+static std::string binaryPath(uint64_t _key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(_key));
+    return std::string("./") + name;
+}
+
+static bool fileExists(const std::string& _path) {
+    return std::ifstream(_path).good();
+}
+
+TEST_CASE("Linked programs are stored and loaded from the program cache", "[ProgramCache][core]") {
+    RenderState rs;
+
+    Hardware::supportsProgramBinary = true;
+    ProgramCache::setDirectory(".");
+
+    auto path = binaryPath(ProgramCache::key(vertSrc, fragSrc));
+    std::remove(path.c_str());
+
+    auto stats = ShaderProgram::buildStats();
+
+    ShaderProgram first;
+    first.setShaderSource(vertSrc, fragSrc);
+    REQUIRE(first.build(rs));
+    CHECK(ShaderProgram::buildStats().compiled == stats.compiled + 1);
+    CHECK(fileExists(path));
+
+    ShaderProgram second;
+    second.setShaderSource(vertSrc, fragSrc);
+    REQUIRE(second.build(rs));
+    CHECK(second.isValid());
+    CHECK(ShaderProgram::buildStats().compiled == stats.compiled + 1);
+    CHECK(ShaderProgram::buildStats().cached == stats.cached + 1);
+
+    std::remove(path.c_str());
+    ProgramCache::setDirectory("");
+}
+
+TEST_CASE("Invalid program binaries fall back to compiling from source", "[ProgramCache][core]") {
+    RenderState rs;
+
+    Hardware::supportsProgramBinary = true;
+    ProgramCache::setDirectory(".");
+
+    auto path = binaryPath(ProgramCache::key(vertSrc, fragSrc));
+    std::ofstream(path) << "not a program binary";
+
+    auto stats = ShaderProgram::buildStats();
+
+    ShaderProgram program;
+    program.setShaderSource(vertSrc, fragSrc);
+    REQUIRE(program.build(rs));
+    CHECK(ShaderProgram::buildStats().compiled == stats.compiled + 1);
+    CHECK(ShaderProgram::buildStats().cached == stats.cached);
+
+    // Replaced by the binary of the newly linked program
+    CHECK(ProgramCache::load(ProgramCache::key(vertSrc, fragSrc)) != 0);
+
+    std::remove(path.c_str());
+    ProgramCache::setDirectory("");
+}
+
+TEST_CASE("Program binaries with a length beyond their file are rejected", "[ProgramCache][core]") {
+    ProgramCache::setDirectory(".");
+
+    uint64_t key = ProgramCache::key(vertSrc, fragSrc);
+    auto path = binaryPath(key);
+    {
+        std::ofstream file(path, std::ofstream::binary | std::ofstream::trunc);
+        uint32_t version = 1, format = 0, length = 0xffffffff;
+        file.write("TGPB", 4);
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.write("binary", 6);
+    }
+
+    CHECK(ProgramCache::load(key) == 0);
+    CHECK_FALSE(fileExists(path));
+
+    ProgramCache::setDirectory("");
+}
+
+TEST_CASE("Program cache keys depend on both shader sources", "[ProgramCache][core]") {
+    CHECK(ProgramCache::key(vertSrc, fragSrc) == ProgramCache::key(vertSrc, fragSrc));
+    CHECK(ProgramCache::key(vertSrc, fragSrc) != ProgramCache::key(fragSrc, vertSrc));
+    CHECK(ProgramCache::key(vertSrc + fragSrc, "") != ProgramCache::key(vertSrc, fragSrc));
+}
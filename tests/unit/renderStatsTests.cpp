@@ -0,0 +1,129 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "debug/frameInfo.h"
+#include "map.h"
+#include "mockPlatform.h"
+
+#include <vector>
+
+using namespace Tangram;
+
+// Renders a scripted camera path with the recording GL backend of the tests
+// and checks the GL calls of each frame against budgets. Budgets are generous,
+// they are meant to catch regressions like per-tile program switches or
+// repeated uploads, not to pin exact numbers.
+
+static const char* sceneYaml = R"END(
+scene:
+    background:
+        color: '#f0ebeb'
+styles:
+    routes:
+        base: lines
+        blend: overlay
+)END";
+
+static const char* lineStyle = "{ style: lines, color: '#4050ff', width: 6px, order: 500 }";
+static const char* routeStyle = "{ style: routes, color: '#ff5040', width: 10px, order: 600 }";
+static const char* areaStyle = "{ style: polygons, color: '#80c080', order: 400 }";
+
+struct CameraStop {
+    double lon, lat;
+    float zoom;
+};
+
+static const std::vector<CameraStop> cameraPath = {
+    { -74.00, 40.70, 12.f },
+    { -74.01, 40.71, 13.f },
+    { -74.02, 40.72, 14.f },
+    { -74.00, 40.71, 15.f },
+    { -73.99, 40.70, 16.f },
+};
+
+struct Budget {
+    uint32_t drawCalls = 64;
+    uint32_t programBinds = 16;
+    uint32_t uniformSets = 512;
+    uint32_t stateChanges = 128;
+};
+
+static void addMarkers(Map& _map) {
+    for (int i = 0; i < 8; i++) {
+        double offset = 0.005 * i;
+
+        std::vector<LngLat> line = {{ -74.03 + offset, 40.68 }, { -73.98 + offset, 40.73 }};
+        auto lineMarker = _map.markerAdd();
+        _map.markerSetStylingFromString(lineMarker, (i % 2) ? routeStyle : lineStyle);
+        _map.markerSetPolyline(lineMarker, line.data(), line.size());
+
+        std::vector<LngLat> area = {{ -74.02 + offset, 40.69 }, { -74.018 + offset, 40.69 },
+                                    { -74.018 + offset, 40.692 }, { -74.02 + offset, 40.692 },
+                                    { -74.02 + offset, 40.69 }};
+        int count = area.size();
+        auto areaMarker = _map.markerAdd();
+        _map.markerSetStylingFromString(areaMarker, areaStyle);
+        _map.markerSetPolygon(areaMarker, area.data(), &count, 1);
+    }
+}
+
+static GLStats renderFrame(Map& _map) {
+    _map.update(1.f / 60.f);
+    _map.render();
+    return FrameInfo::frameStats();
+}
+
+TEST_CASE("Frames along a camera path stay within GL call budgets", "[RenderStats]") {
+    auto platform = std::make_shared<MockPlatform>();
+    Map map(platform);
+
+    map.setupGL();
+    map.resize(800, 600);
+    map.loadSceneYaml(sceneYaml, "");
+
+    addMarkers(map);
+
+    Budget budget;
+
+    for (auto& stop : cameraPath) {
+        map.setPosition(stop.lon, stop.lat);
+        map.setZoom(stop.zoom);
+
+        // Let marker meshes build and upload before measuring
+        renderFrame(map);
+        auto stats = renderFrame(map);
+
+        INFO("zoom " << stop.zoom);
+        CHECK(stats.drawCalls > 0);
+        CHECK(stats.drawCalls <= budget.drawCalls);
+        CHECK(stats.programBinds <= budget.programBinds);
+        CHECK(stats.uniformSets <= budget.uniformSets);
+        CHECK(stats.stateChanges <= budget.stateChanges);
+    }
+}
+
+TEST_CASE("Rendering an unchanged view uploads nothing", "[RenderStats]") {
+    auto platform = std::make_shared<MockPlatform>();
+    Map map(platform);
+
+    map.setupGL();
+    map.resize(800, 600);
+    map.loadSceneYaml(sceneYaml, "");
+
+    addMarkers(map);
+
+    map.setPosition(-74.00, 40.70);
+    map.setZoom(14.f);
+
+    renderFrame(map);
+    auto first = renderFrame(map);
+    auto second = renderFrame(map);
+
+    CHECK(second.bufferUploadBytes == 0);
+    CHECK(second.textureUploadBytes == 0);
+
+    // Same work for the same view
+    CHECK(second.drawCalls == first.drawCalls);
+    CHECK(second.programBinds <= first.programBinds);
+    CHECK(second.uniformSets <= first.uniformSets);
+}
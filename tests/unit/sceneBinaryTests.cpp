@@ -0,0 +1,86 @@
+#include "catch.hpp"
+
+#include "mockPlatform.h"
+#include "scene/importer.h"
+#include "scene/sceneBinary.h"
+#include "scene/sceneDiff.h"
+
+#include "yaml-cpp/yaml.h"
+
+#include <cstring>
+
+using namespace Tangram;
+
+static const char* sceneYaml = R"END(
+    sources: { osm: { type: MVT, url: "tiles/{z}/{x}/{y}.mvt", max_zoom: 16 } }
+    textures: { icons: { url: img/icons.png, sprites: { a: [0, 0, 8, 8] } } }
+    layers:
+        roads:
+            data: { source: osm }
+            filter: { kind: !!str 1, $zoom: { min: 10 } }
+            draw: { lines: { order: 1, width: [[10, 1px], [16, 4px]], color: 'function() { return "red"; }' } }
+    empty:
+)END";
+
+TEST_CASE("Scene configs are equal after writing and reading them as binary", "[SceneBinary][core]") {
+    YAML::Node config = YAML::Load(sceneYaml);
+
+    auto data = SceneBinary::write(config);
+    REQUIRE(SceneBinary::isSceneBinary(data));
+
+    YAML::Node result;
+    REQUIRE(SceneBinary::read(data, result));
+
+    CHECK(SceneDiff::isEqual(config, result));
+    CHECK(result["empty"].IsNull());
+
+    // Explicit tags are kept for filters
+    CHECK(result["layers"]["roads"]["filter"]["kind"].Tag() == "tag:yaml.org,2002:str");
+}
+
+TEST_CASE("Invalid scene binaries are not read", "[SceneBinary][core]") {
+    auto data = SceneBinary::write(YAML::Load(sceneYaml));
+    YAML::Node result;
+
+    auto truncated = data;
+    truncated.pop_back();
+    CHECK_FALSE(SceneBinary::read(truncated, result));
+
+    // The version follows the magic bytes
+    auto otherVersion = data;
+    otherVersion[4]++;
+    CHECK_FALSE(SceneBinary::read(otherVersion, result));
+
+    std::vector<char> yaml(sceneYaml, sceneYaml + strlen(sceneYaml));
+    CHECK_FALSE(SceneBinary::isSceneBinary(yaml));
+    CHECK_FALSE(SceneBinary::read(yaml, result));
+}
+
+TEST_CASE("Scene binaries nesting deeper than the maximum depth are not read", "[SceneBinary][core]") {
+    auto nested = [](int _depth) {
+        YAML::Node root(YAML::NodeType::Sequence);
+        YAML::Node node = root;
+        for (int i = 0; i < _depth; i++) {
+            YAML::Node child(YAML::NodeType::Sequence);
+            node.push_back(child);
+            node.reset(child);
+        }
+        return SceneBinary::write(root);
+    };
+
+    YAML::Node result;
+    CHECK(SceneBinary::read(nested(SceneBinary::maxDepth), result));
+    CHECK_FALSE(SceneBinary::read(nested(SceneBinary::maxDepth + 1), result));
+}
+
+TEST_CASE("Scene binaries are imported with URLs resolved against their location", "[SceneBinary][import][core]") {
+    auto platform = std::make_shared<MockPlatform>();
+    platform->putMockUrlContents("/root/scene.tgsb", SceneBinary::write(YAML::Load(sceneYaml)));
+
+    Importer importer(std::make_shared<Scene>(platform, Url("/root/scene.tgsb")));
+    auto root = importer.applySceneImports(platform);
+
+    CHECK(root["sources"]["osm"]["url"].Scalar() == "/root/tiles/{z}/{x}/{y}.mvt");
+    CHECK(root["textures"]["icons"]["url"].Scalar() == "/root/img/icons.png");
+    CHECK(root["layers"]["roads"]["data"]["source"].Scalar() == "osm");
+}
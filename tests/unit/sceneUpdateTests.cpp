@@ -4,6 +4,7 @@
 #include "map.h"
 #include "mockPlatform.h"
 #include "scene/scene.h"
+#include "scene/sceneDiff.h"
 #include "scene/sceneLoader.h"
 #include "style/style.h"
 
@@ -249,3 +250,81 @@ TEST_CASE("Scene update statuses") {
     CHECK(scene.errors.front().error == Error::scene_update_value_yaml_syntax_error);
     scene.errors.clear();
 }
+
+const static std::string diffSceneString = R"END(
+sources:
+    osm:
+        type: MVT
+        url: https://example.com/{z}/{x}/{y}.mvt
+    terrain:
+        type: Raster
+        url: https://example.com/terrain/{z}/{x}/{y}.png
+    hillshade:
+        type: GeoJSON
+        url: https://example.com/{z}/{x}/{y}.json
+        rasters: [terrain]
+layers:
+    water:
+        data: { source: osm }
+        draw: { polygons: { color: blue } }
+    hills:
+        data: { source: hillshade }
+        draw: { polygons: { color: gray } }
+styles:
+    tint:
+        base: polygons
+        shaders:
+            uniforms:
+                u_tint: [1, 0, 0]
+cameras:
+    main: { type: flat }
+)END";
+
+SceneDiff diffUpdates(const std::vector<SceneUpdate>& _updates) {
+    auto platform_mock = std::make_shared<MockPlatform>();
+    Scene prev(platform_mock, Url());
+    REQUIRE(loadConfig(diffSceneString, prev.config()));
+    REQUIRE(SceneLoader::applyUpdates(platform_mock, prev, {}));
+
+    Scene next;
+    next.copyConfig(prev);
+    REQUIRE(SceneLoader::applyUpdates(platform_mock, next, _updates));
+
+    return SceneDiff::compare(prev, next);
+}
+
+TEST_CASE("Scene diff of a layer update rebuilds only the layer source") {
+    auto diff = diffUpdates({{"layers.water.draw.polygons.color", "red"}});
+    CHECK(diff.layerSources == std::set<std::string>{"osm"});
+    CHECK(diff.sources.empty());
+    CHECK(diff.styles.empty());
+    CHECK_FALSE(diff.rebuildAll);
+    CHECK(diff.keepsTiles());
+}
+
+TEST_CASE("Scene diff of uniform values keeps styles") {
+    auto diff = diffUpdates({{"styles.tint.shaders.uniforms.u_tint", "[0, 1, 0]"}});
+    CHECK(diff.uniformStyles == std::set<std::string>{"tint"});
+    CHECK(diff.styles.empty());
+    CHECK(diff.layerSources.empty());
+    CHECK(diff.keepsTiles());
+
+    diff = diffUpdates({{"styles.tint.base", "lines"}});
+    CHECK(diff.styles == std::set<std::string>{"tint"});
+    CHECK_FALSE(diff.keepsTiles());
+}
+
+TEST_CASE("Scene diff of a raster source reloads the sources that use it") {
+    auto diff = diffUpdates({{"sources.terrain.url", "https://example.com/dem/{z}/{x}/{y}.png"}});
+    CHECK(diff.sources == std::set<std::string>({"terrain", "hillshade"}));
+    CHECK(diff.layerSources.empty());
+}
+
+TEST_CASE("Scene diff ignores camera updates and flags unknown changes") {
+    auto diff = diffUpdates({{"cameras.main.type", "perspective"}});
+    CHECK(diff.empty());
+
+    diff = diffUpdates({{"lights", "{ sun: { type: directional } }"}});
+    CHECK(diff.structural);
+    CHECK_FALSE(diff.keepsTiles());
+}
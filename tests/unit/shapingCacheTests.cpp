@@ -0,0 +1,70 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "text/shapingCache.h"
+
+using namespace Tangram;
+
+static ShapingCache::Key makeKey(const char* _text) {
+    return { icu::UnicodeString::fromUTF8(_text), nullptr, 1.f, 0.f, 15, 0, true, 1 };
+}
+
+static ShapingCache::Entry makeEntry(size_t _quads, size_t _atlas) {
+    ShapingCache::Entry entry;
+    entry.quads.resize(_quads);
+    entry.textRanges = {{ Range(0, int(_quads)), Range(int(_quads), 0), Range(int(_quads), 0) }};
+    entry.size = glm::vec2(10.f, 5.f);
+    entry.atlases[_atlas] = true;
+    return entry;
+}
+
+TEST_CASE("Shaping cache returns layouts of repeated texts", "[ShapingCache]") {
+    ShapingCache cache;
+
+    REQUIRE(cache.get(makeKey("Main Street")) == nullptr);
+
+    cache.put(makeKey("Main Street"), makeEntry(11, 0));
+
+    auto* entry = cache.get(makeKey("Main Street"));
+    REQUIRE(entry != nullptr);
+    REQUIRE(entry->quads.size() == 11);
+
+    // Same text with other layout parameters is a different entry
+    auto key = makeKey("Main Street");
+    key.maxLineWidth = 8;
+    REQUIRE(cache.get(key) == nullptr);
+
+    auto stats = cache.stats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.entries == 1);
+}
+
+TEST_CASE("Shaping cache evicts least recently used entries", "[ShapingCache]") {
+    ShapingCache cache(2);
+
+    cache.put(makeKey("A"), makeEntry(1, 0));
+    cache.put(makeKey("B"), makeEntry(1, 0));
+
+    // Touch A so that B is evicted next
+    REQUIRE(cache.get(makeKey("A")) != nullptr);
+
+    cache.put(makeKey("C"), makeEntry(1, 0));
+
+    REQUIRE(cache.stats().entries == 2);
+    REQUIRE(cache.get(makeKey("A")) != nullptr);
+    REQUIRE(cache.get(makeKey("B")) == nullptr);
+    REQUIRE(cache.get(makeKey("C")) != nullptr);
+}
+
+TEST_CASE("Shaping cache drops entries of cleared atlases", "[ShapingCache]") {
+    ShapingCache cache;
+
+    cache.put(makeKey("A"), makeEntry(1, 0));
+    cache.put(makeKey("B"), makeEntry(1, 1));
+
+    cache.invalidateAtlas(1);
+
+    REQUIRE(cache.get(makeKey("A")) != nullptr);
+    REQUIRE(cache.get(makeKey("B")) == nullptr);
+}
@@ -1,12 +1,18 @@
 #include "catch.hpp"
 
+#include "gl/glStats.h"
+#include "gl/renderState.h"
+#include "gl/shaderProgram.h"
 #include "log.h"
 #include "mockPlatform.h"
 #include "scene/filters.h"
 #include "scene/importer.h"
 #include "scene/scene.h"
 #include "scene/sceneLoader.h"
+#include "style/material.h"
+#include "style/polygonStyle.h"
 #include "util/variant.h"
+#include "view/view.h"
 
 #include "yaml-cpp/yaml.h"
 
@@ -123,3 +129,40 @@ TEST_CASE( "Style Uniforms Parsing and Injection Test: textures uniform value",
     REQUIRE(uniformValues.value.get<UniformTextureArray>().names[1] == "img/normals.jpg");
     REQUIRE(uniformValues.value.get<UniformTextureArray>().names[2] == "img/sem.jpg");
 }
+
+TEST_CASE( "Styles sharing a program set their own material uniforms", "[StyleUniforms][core]") {
+    std::shared_ptr<Platform> platform = std::make_shared<MockPlatform>();
+    auto scenePtr = std::make_shared<Scene>(platform, Url());
+    auto& scene = *scenePtr;
+    RenderState rs;
+    View view(256, 256);
+
+    for (auto name : { "a", "b" }) {
+        scene.styles().push_back(std::make_unique<PolygonStyle>(name));
+        scene.styles().back()->build(scene);
+    }
+    auto& a = *scene.styles()[0];
+    auto& b = *scene.styles()[1];
+
+    a.getMaterial().setDiffuse(glm::vec4(1, 0, 0, 1));
+    b.getMaterial().setDiffuse(glm::vec4(0, 0, 1, 1));
+
+    REQUIRE(a.shaderProgram() == b.shaderProgram());
+
+    auto& stats = GLStats::recorder();
+
+    a.onBeginDrawFrame(rs, view, scene);
+
+    // Nothing changed since the last frame of this style
+    uint32_t uniformSets = stats.uniformSets;
+    a.onBeginDrawFrame(rs, view, scene);
+    CHECK(stats.uniformSets == uniformSets);
+
+    // Each style sets its diffuse color again after the other one used the program
+    b.onBeginDrawFrame(rs, view, scene);
+    CHECK(stats.uniformSets > uniformSets);
+
+    uniformSets = stats.uniformSets;
+    a.onBeginDrawFrame(rs, view, scene);
+    CHECK(stats.uniformSets > uniformSets);
+}
@@ -1,6 +1,7 @@
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 
+#include "gl/renderState.h"
 #include "gl/texture.h"
 
 using namespace Tangram;
@@ -9,6 +10,7 @@ class TestTexture : public Texture {
 public:
     using Texture::Texture;
     const std::vector<DirtyRange>& dirtyRanges() { return m_dirtyRanges; }
+    const std::vector<DirtyRect>& dirtyRects() { return m_dirtyRects; }
 };
 
 TEST_CASE("Merging of dirty Regions - Non overlapping, test ordering", "[Texture]") {
@@ -113,3 +115,74 @@ TEST_CASE("Merging of dirty Regions - Merge three regions, when 3rd region is ad
     }
 
 }
+
+TEST_CASE("Merging of dirty Rects - Neighbors are coalesced, distant rects are kept apart", "[Texture]") {
+    TestTexture texture(512, 512);
+
+    // Two glyphs next to each other on one shelf
+    texture.setDirtyRect(0, 0, 20, 20);
+    texture.setDirtyRect(20, 0, 20, 20);
+    REQUIRE(texture.dirtyRects().size() == 1);
+    REQUIRE(texture.dirtyRects()[0].x0 == 0);
+    REQUIRE(texture.dirtyRects()[0].x1 == 40);
+    REQUIRE(texture.dirtyRects()[0].y1 == 20);
+
+    // A glyph on the other side of the atlas
+    texture.setDirtyRect(400, 300, 20, 20);
+    REQUIRE(texture.dirtyRects().size() == 2);
+
+    // Full width regions are tracked as row ranges
+    texture.setDirtyRect(0, 100, 512, 10);
+    REQUIRE(texture.dirtyRects().size() == 2);
+    REQUIRE(texture.dirtyRanges().size() == 1);
+}
+
+TEST_CASE("Texture storage is reported to GPUMemory by category", "[Texture][GPUMemory]") {
+    RenderState rs;
+
+    size_t glyphs = GPUMemory::usage(GPUMemory::glyphs);
+    size_t rasters = GPUMemory::usage(GPUMemory::rasters);
+
+    {
+        Texture texture(64, 32);
+        texture.setMemoryCategory(GPUMemory::glyphs);
+
+        // Nothing is allocated before the first upload
+        REQUIRE(GPUMemory::usage(GPUMemory::glyphs) == glyphs);
+
+        texture.update(rs, 0);
+        REQUIRE(GPUMemory::usage(GPUMemory::glyphs) == glyphs + 64 * 32);
+
+        texture.setMemoryCategory(GPUMemory::rasters);
+        REQUIRE(GPUMemory::usage(GPUMemory::glyphs) == glyphs);
+        REQUIRE(GPUMemory::usage(GPUMemory::rasters) == rasters + 64 * 32);
+
+        texture.releaseGPUMemory();
+        REQUIRE(!texture.isValid());
+        REQUIRE(GPUMemory::usage(GPUMemory::rasters) == rasters);
+
+        texture.update(rs, 0);
+        REQUIRE(texture.isValid());
+        REQUIRE(GPUMemory::usage(GPUMemory::rasters) == rasters + 64 * 32);
+    }
+
+    REQUIRE(GPUMemory::usage(GPUMemory::rasters) == rasters);
+}
+
+TEST_CASE("GPUMemory reports usage above the budget", "[GPUMemory]") {
+    size_t total = GPUMemory::totalUsage();
+
+    GPUMemory::update(GPUMemory::geometry, 0, 1024);
+    REQUIRE(GPUMemory::totalUsage() == total + 1024);
+
+    GPUMemory::setBudget(0);
+    REQUIRE(GPUMemory::overBudget() == 0);
+
+    GPUMemory::setBudget(total + 256);
+    REQUIRE(GPUMemory::overBudget() == 768);
+
+    GPUMemory::update(GPUMemory::geometry, 1024, 0);
+    REQUIRE(GPUMemory::overBudget() == 0);
+
+    GPUMemory::setBudget(0);
+}
@@ -0,0 +1,77 @@
+#include "catch.hpp"
+
+#include "style/polygonStyle.h"
+#include "tile/tileCache.h"
+#include "util/mapProjection.h"
+
+#include <memory>
+
+using namespace Tangram;
+
+static MercatorProjection s_projection;
+
+struct TestMesh : StyledMesh {
+    size_t size;
+    TestMesh(size_t _size) : size(_size) {}
+    bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true) override { return true; }
+    size_t bufferSize() const override { return size; }
+};
+
+static std::shared_ptr<Tile> makeTile(TileID _id, size_t _meshSize) {
+    static PolygonStyle style("test");
+    auto tile = std::make_shared<Tile>(_id, s_projection);
+    tile->setMesh(style, std::make_unique<TestMesh>(_meshSize));
+    return tile;
+}
+
+TEST_CASE("TileCache counts hits and misses of get()", "[TileCache]") {
+    TileCache cache(1 << 20);
+
+    cache.put(0, makeTile({1, 2, 3}, 100));
+    cache.put(0, makeTile({2, 2, 3}, 50));
+    CHECK(cache.size() == 2);
+    CHECK(cache.getMemoryUsage() == 150);
+
+    // Tiles of other sources and missing tiles are misses
+    CHECK(cache.get(1, {1, 2, 3}) == nullptr);
+    CHECK(cache.get(0, {3, 2, 3}) == nullptr);
+
+    // A hit takes the tile out of the cache
+    REQUIRE(cache.get(0, {1, 2, 3}) != nullptr);
+    CHECK(cache.get(0, {1, 2, 3}) == nullptr);
+
+    CHECK(cache.hits() == 1);
+    CHECK(cache.misses() == 3);
+    CHECK(cache.size() == 1);
+    CHECK(cache.getMemoryUsage() == 50);
+
+    // contains() does not count
+    CHECK(cache.contains(0, {2, 2, 3}) != nullptr);
+    CHECK(cache.hits() == 1);
+    CHECK(cache.misses() == 3);
+
+    cache.resetStats();
+    CHECK(cache.hits() == 0);
+    CHECK(cache.misses() == 0);
+    CHECK(cache.size() == 1);
+
+    REQUIRE(cache.get(0, {2, 2, 3}) != nullptr);
+    CHECK(cache.hits() == 1);
+    CHECK(cache.misses() == 0);
+}
+
+TEST_CASE("TileCache drops least recently put tiles beyond its size", "[TileCache]") {
+    TileCache cache(200);
+
+    cache.put(0, makeTile({1, 2, 3}, 100));
+    cache.put(0, makeTile({2, 2, 3}, 100));
+    auto popped = cache.put(0, makeTile({3, 2, 3}, 100));
+
+    REQUIRE(popped.size() == 1);
+    CHECK(popped[0] == TileID(1, 2, 3));
+    CHECK(cache.size() == 2);
+    CHECK(cache.getMemoryUsage() == 200);
+
+    CHECK(cache.get(0, {1, 2, 3}) == nullptr);
+    CHECK(cache.misses() == 1);
+}
@@ -2,6 +2,7 @@
 
 #include "data/tileSource.h"
 #include "mockPlatform.h"
+#include "style/polygonStyle.h"
 #include "tile/tileManager.h"
 #include "tile/tileWorker.h"
 #include "util/mapProjection.h"
@@ -15,9 +16,22 @@ using namespace Tangram;
 MercatorProjection s_projection;
 ViewState viewState { &s_projection, true, glm::vec2(0), 1, 0, 1.f, glm::vec2(0), 256.f };
 
+struct TestMesh : StyledMesh {
+    size_t size;
+    TestMesh(size_t _size) : size(_size) {}
+    bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true) override { return true; }
+    size_t bufferSize() const override { return size; }
+};
+
+static const Style& meshStyle() {
+    static PolygonStyle style("test");
+    return style;
+}
+
 struct TestTileWorker : TileTaskQueue {
     int processedCount = 0;
     bool pendingTiles = false;
+    size_t meshSize = 0;
 
     std::deque<std::shared_ptr<TileTask>> tasks;
 
@@ -42,6 +56,9 @@ struct TestTileWorker : TileTaskQueue {
             }
 
             task->tile() = std::make_shared<Tile>(task->tileId(), s_projection, &task->source());
+            if (meshSize > 0) {
+                task->tile()->setMesh(meshStyle(), std::make_unique<TestMesh>(meshSize));
+            }
 
             pendingTiles = true;
             processedCount++;
@@ -115,6 +132,8 @@ public:
         // Mimic TileManager::updateTileSets(View& _view)
         m_tiles.clear();
         m_tilesInProgress = 0;
+        m_tilesPendingUpload = 0;
+        m_uploadBytes = 0;
         m_tileSetChanged = false;
 
         TileSet& tileSet = m_tileSets[0];
@@ -217,6 +236,36 @@ TEST_CASE( "Load visible Tile", "[TileManager][updateTileSets]" ) {
 
 }
 
+TEST_CASE( "Loaded tiles beyond the upload budget wait for later updates", "[TileManager][updateTileSets]" ) {
+    TestTileWorker worker;
+    worker.meshSize = 1024;
+    TestTileManager tileManager(std::make_shared<MockPlatform>(), worker);
+    tileManager.setUploadBudget(2048);
+
+    auto source = std::make_shared<TestTileSource>();
+    std::vector<std::shared_ptr<TileSource>> sources = { source };
+    tileManager.setTileSources(sources);
+
+    std::set<TileID> visibleTiles = {TileID{0,0,1}, TileID{0,1,1}, TileID{1,0,1}, TileID{1,1,1}};
+    tileManager.updateTiles(viewState, visibleTiles);
+    while (!worker.tasks.empty()) { worker.processTask(); }
+
+    REQUIRE(worker.processedCount == 4);
+
+    tileManager.updateTiles(viewState, visibleTiles);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 2);
+    REQUIRE(tileManager.pendingUploads() == 2);
+    REQUIRE(tileManager.uploadBytes() == 2048);
+    REQUIRE(tileManager.hasLoadingTiles());
+
+    tileManager.updateTiles(viewState, visibleTiles);
+
+    REQUIRE(tileManager.getVisibleTiles().size() == 4);
+    REQUIRE(tileManager.pendingUploads() == 0);
+    REQUIRE(source->tileTaskCount == 4);
+}
+
 
 TEST_CASE( "Use proxy Tile", "[TileManager][updateTileSets]" ) {
     TestTileWorker worker;
@@ -0,0 +1,116 @@
+#include "catch.hpp"
+
+#include "data/tileData.h"
+#include "data/tileSource.h"
+#include "mockPlatform.h"
+#include "scene/scene.h"
+#include "tile/tile.h"
+#include "tile/tileTask.h"
+#include "tile/tileWorker.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Tangram;
+
+// Decodes every tile to empty TileData
+class TestTileSource : public TileSource {
+public:
+    TestTileSource(int _delayMs = 0) : TileSource("test", nullptr), delay(_delayMs) {}
+
+    std::shared_ptr<TileData> parse(const TileTask& _task, const MapProjection& _projection) const override {
+        active++;
+        std::this_thread::sleep_for(delay);
+        active--;
+        decoded++;
+        return std::make_shared<TileData>();
+    }
+
+    std::chrono::milliseconds delay;
+    mutable std::atomic<int> decoded{0};
+    // Number of tiles being decoded
+    mutable std::atomic<int> active{0};
+};
+
+static void runTasks(int _numWorker, int _numDecoder) {
+    auto platform = std::make_shared<MockPlatform>();
+    auto scene = std::make_shared<Scene>(platform, Url());
+    auto source = std::make_shared<TestTileSource>();
+
+    TileWorker worker(platform, _numWorker, _numDecoder);
+    worker.setScene(scene);
+
+    std::vector<std::shared_ptr<TileTask>> tasks;
+    for (int x = 0; x < 16; x++) {
+        TileID id(x, 0, 4);
+        tasks.push_back(std::make_shared<TileTask>(id, source, -1));
+    }
+    tasks[3]->cancel();
+
+    for (auto& task : tasks) {
+        worker.enqueue(task);
+    }
+
+    for (int i = 0; i < 500 && worker.buildTime().count() < 15; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    worker.stop();
+
+    CHECK(worker.pendingTasks() == 0);
+    CHECK(source->decoded == 15);
+    CHECK(worker.decodeTime().count() == 15);
+    CHECK(worker.buildTime().count() == 15);
+
+    for (size_t i = 0; i < tasks.size(); i++) {
+        // Canceled tasks are neither decoded nor built
+        CHECK(bool(tasks[i]->tile()) == (i != 3));
+    }
+}
+
+TEST_CASE("TileWorker decodes and builds tiles on its workers", "[TileWorker]") {
+    runTasks(2, 0);
+}
+
+TEST_CASE("TileWorker passes decoded tiles from decoder threads to its workers", "[TileWorker]") {
+    runTasks(2, 1);
+    runTasks(1, 3);
+}
+
+TEST_CASE("TileWorker holds back builds while running a function", "[TileWorker]") {
+    auto platform = std::make_shared<MockPlatform>();
+    auto scene = std::make_shared<Scene>(platform, Url());
+    auto source = std::make_shared<TestTileSource>(5);
+
+    TileWorker worker(platform, 2);
+    worker.setScene(scene);
+
+    for (int x = 0; x < 16; x++) {
+        TileID id(x, 0, 4);
+        worker.enqueue(std::make_shared<TileTask>(id, source, -1));
+    }
+
+    for (int i = 0; i < 500 && source->active == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    int activeBefore = -1, decodedBefore = -1, decodedAfter = -1;
+    worker.runWhileIdle([&]() {
+        activeBefore = source->active;
+        decodedBefore = source->decoded;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        decodedAfter = source->decoded;
+    });
+
+    CHECK(activeBefore == 0);
+    CHECK(decodedBefore == decodedAfter);
+
+    // Builds continue afterwards
+    for (int i = 0; i < 500 && worker.buildTime().count() < 16; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    worker.stop();
+
+    CHECK(worker.buildTime().count() == 16);
+}
@@ -0,0 +1,127 @@
+#include "catch.hpp"
+
+#include "data/tileSource.h"
+#include "debug/tracer.h"
+#include "tile/tileTask.h"
+
+#include "rapidjson/document.h"
+
+#include <string>
+#include <thread>
+
+using namespace Tangram;
+
+static int countEvents(const rapidjson::Document& _trace, const char* _name) {
+    int count = 0;
+    for (const auto& event : _trace.GetArray()) {
+        if (std::string(event["name"].GetString()) == _name) { count++; }
+    }
+    return count;
+}
+
+TEST_CASE("Tracer writes recorded spans as Chrome trace events", "[Tracer]") {
+    Tracer::clear();
+
+    // Nothing is recorded while disabled
+    Tracer::setEnabled(false);
+    Tracer::instant("disabled", "test");
+    { TraceScope scope("disabled scope", "test"); }
+
+    Tracer::setEnabled(true);
+
+    {
+        TraceScope scope("first", "test");
+        scope.next("second");
+    }
+    std::thread([]() {
+        Tracer::span("other thread", "test", 1, 11, TileID(3, 5, 4));
+    }).join();
+
+    auto source = std::make_shared<TileSource>("test", nullptr);
+    TileID id(1, 2, 3);
+    TileTask task(id, source, -1);
+    task.trace(TileTask::Stage::loaded);
+    task.trace(TileTask::Stage::building);
+    task.trace(TileTask::Stage::built);
+
+    Tracer::setEnabled(false);
+
+    rapidjson::Document trace;
+    trace.Parse(Tracer::json().c_str());
+    REQUIRE(trace.IsArray());
+
+    CHECK(countEvents(trace, "disabled") == 0);
+    CHECK(countEvents(trace, "disabled scope") == 0);
+    CHECK(countEvents(trace, "first") == 1);
+    CHECK(countEvents(trace, "second") == 1);
+    CHECK(countEvents(trace, "load") == 1);
+    CHECK(countEvents(trace, "build") == 1);
+    // The decode stages were skipped, so the build wait starts when loaded
+    CHECK(countEvents(trace, "wait for build") == 1);
+    CHECK(countEvents(trace, "decode") == 0);
+    CHECK(task.stageTime(TileTask::Stage::built) >= task.stageTime(TileTask::Stage::loaded));
+
+    for (const auto& event : trace.GetArray()) {
+        if (std::string(event["name"].GetString()) == "other thread") {
+            CHECK(std::string(event["ph"].GetString()) == "X");
+            CHECK(event["ts"].GetInt64() == 1);
+            CHECK(event["dur"].GetInt64() == 10);
+            CHECK(std::string(event["args"]["tile"].GetString()) == "4/3/5");
+        }
+        if (std::string(event["name"].GetString()) == "build") {
+            CHECK(std::string(event["args"]["tile"].GetString()) == "3/1/2");
+        }
+    }
+
+    Tracer::clear();
+    trace.Parse(Tracer::json().c_str());
+    REQUIRE(trace.IsArray());
+    CHECK(trace.Size() == 0);
+}
+
+TEST_CASE("Tracer keeps the most recent events of each thread", "[Tracer]") {
+    Tracer::clear();
+    Tracer::setEnabled(true);
+
+    for (size_t i = 0; i < Tracer::bufferSize + 10; i++) {
+        Tracer::span("event", "test", i, i + 1);
+    }
+
+    Tracer::setEnabled(false);
+
+    rapidjson::Document trace;
+    trace.Parse(Tracer::json().c_str());
+    REQUIRE(trace.IsArray());
+    REQUIRE(trace.Size() == Tracer::bufferSize);
+    CHECK(trace[0]["ts"].GetInt64() == 10);
+
+    Tracer::clear();
+}
+
+TEST_CASE("Tracer keeps the events of exited threads until clear", "[Tracer]") {
+    Tracer::clear();
+    Tracer::setEnabled(true);
+
+    for (int i = 0; i < 4; i++) {
+        std::thread([]() { Tracer::instant("exited thread", "test"); }).join();
+    }
+
+    rapidjson::Document trace;
+    trace.Parse(Tracer::json().c_str());
+    REQUIRE(trace.IsArray());
+    CHECK(countEvents(trace, "exited thread") == 4);
+
+    // Only the most recently exited threads keep their events
+    for (size_t i = 0; i < Tracer::maxRetiredBuffers; i++) {
+        std::thread([]() { Tracer::instant("exited later", "test"); }).join();
+    }
+
+    Tracer::setEnabled(false);
+
+    trace.Parse(Tracer::json().c_str());
+    REQUIRE(trace.IsArray());
+    CHECK(countEvents(trace, "exited thread") == 0);
+    CHECK(countEvents(trace, "exited later") == int(Tracer::maxRetiredBuffers));
+
+    Tracer::clear();
+}
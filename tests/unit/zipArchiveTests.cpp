@@ -0,0 +1,80 @@
+#include "catch.hpp"
+
+#include "util/zipArchive.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Tangram;
+
+static const std::string storedText = "stored entry, served from the archive data";
+static const std::string compressedText(4096, 'x');
+
+static std::vector<char> createArchive() {
+    mz_zip_archive zip;
+    mz_zip_zero_struct(&zip);
+    mz_zip_writer_init_heap(&zip, 0, 0);
+    mz_zip_writer_add_mem(&zip, "stored.txt", storedText.data(), storedText.size(), MZ_NO_COMPRESSION);
+    mz_zip_writer_add_mem(&zip, "dir/compressed.txt", compressedText.data(), compressedText.size(), MZ_BEST_COMPRESSION);
+
+    void* data = nullptr;
+    size_t size = 0;
+    mz_zip_writer_finalize_heap_archive(&zip, &data, &size);
+    std::vector<char> archive(static_cast<char*>(data), static_cast<char*>(data) + size);
+    mz_zip_writer_end(&zip);
+    return archive;
+}
+
+static std::string readWhole(ZipArchive& archive, const ZipArchive::Entry* entry) {
+    std::string result(entry->uncompressedSize, '\0');
+    return archive.decompressEntry(entry, &result[0]) ? result : "";
+}
+
+TEST_CASE("Zip archive entries are read from memory", "[ZipArchive][core]") {
+    ZipArchive archive;
+    REQUIRE(archive.loadFromMemory(createArchive()));
+    REQUIRE(archive.entries().size() == 2);
+
+    auto stored = archive.findEntry("stored.txt");
+    auto compressed = archive.findEntry("dir/compressed.txt");
+    REQUIRE(stored);
+    REQUIRE(compressed);
+
+    CHECK(stored->storedData != nullptr);
+    CHECK(compressed->storedData == nullptr);
+
+    std::string output(compressed->uncompressedSize, '\0');
+    REQUIRE(archive.decompressEntry(compressed, &output[0]));
+    CHECK(output == compressedText);
+
+    output.assign(stored->uncompressedSize, '\0');
+    REQUIRE(archive.decompressEntry(stored, &output[0]));
+    CHECK(output == storedText);
+}
+
+TEST_CASE("Zip archive files are mapped and entries read on demand", "[ZipArchive][core]") {
+    const char* path = "./zipArchiveTest.zip";
+    auto data = createArchive();
+    std::ofstream(path, std::ios::binary).write(data.data(), data.size());
+
+    ZipArchive archive;
+    REQUIRE(archive.loadFromFile(path));
+
+    auto stored = archive.findEntry("stored.txt");
+    REQUIRE(stored);
+    // Points into the mapping
+    REQUIRE(stored->storedData != nullptr);
+    CHECK(std::string(stored->storedData, stored->uncompressedSize) == storedText);
+    CHECK(readWhole(archive, stored) == storedText);
+
+    auto compressed = archive.findEntry("dir/compressed.txt");
+    REQUIRE(compressed);
+    CHECK(readWhole(archive, compressed) == compressedText);
+
+    archive.reset();
+    std::remove(path);
+
+    CHECK_FALSE(archive.loadFromFile(path));
+}
@@ -33,7 +33,44 @@ add_definitions(-DTANGRAM_LINUX)
 # load core library
 add_subdirectory(${PROJECT_SOURCE_DIR}/core)
 
-if(TANGRAM_APPLICATION)
+if(TANGRAM_HEADLESS)
+
+  # Renders images without window or GPU, using the OSMesa software renderer.
+  # Builds without GLFW, OpenGL and X11, and instead of the tangram application.
+  include(FindPkgConfig)
+  pkg_check_modules(OSMESA REQUIRED "osmesa")
+
+  # System font config
+  pkg_check_modules(FONTCONFIG REQUIRED "fontconfig")
+
+  add_executable(tangram-headless
+    ${PROJECT_SOURCE_DIR}/platforms/linux/src/linuxPlatform.cpp
+    ${PROJECT_SOURCE_DIR}/platforms/linux/src/headless.cpp
+    ${PROJECT_SOURCE_DIR}/platforms/common/platform_gl.cpp
+    ${PROJECT_SOURCE_DIR}/platforms/common/urlClient.cpp
+    ${PROJECT_SOURCE_DIR}/platforms/common/linuxSystemFontHelper.cpp
+    )
+
+  target_compile_definitions(tangram-headless PRIVATE -DTANGRAM_HEADLESS)
+
+  target_include_directories(tangram-headless
+    PUBLIC
+    ${PROJECT_SOURCE_DIR}/platforms/common
+    ${OSMESA_INCLUDE_DIRS}
+    ${FONTCONFIG_INCLUDE_DIRS})
+
+  target_link_libraries(tangram-headless
+    ${CORE_LIBRARY}
+    miniz
+    -lcurl
+    -ldl
+    -pthread
+    ${OSMESA_LDFLAGS}
+    ${FONTCONFIG_LDFLAGS})
+
+  add_resources(tangram-headless "${PROJECT_SOURCE_DIR}/scenes")
+
+elseif(TANGRAM_APPLICATION)
 
   set(EXECUTABLE_NAME "tangram")
 
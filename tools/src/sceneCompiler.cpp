@@ -0,0 +1,146 @@
+#include "log.h"
+#include "mockPlatform.h"
+#include "scene/importer.h"
+#include "scene/scene.h"
+#include "scene/sceneBinary.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+using namespace Tangram;
+
+// Compiles a YAML scene with its imports into a SceneBinary, see
+// scene/sceneBinary.h. URLs of files in the directory of the scene are
+// stored relative to it, so the binary must be placed next to the scene.
+//
+// Usage: sceneCompiler.out <scene.yaml> <scene.tgsb>
+
+class FilePlatform : public MockPlatform {
+
+public:
+
+    UrlRequestHandle startUrlRequest(Url _url, UrlCallback _callback) override {
+        UrlResponse response;
+
+        if (_url.hasHttpScheme()) {
+            response.error = "Remote imports can not be compiled";
+        } else {
+            response.content = getBytesFromFile(_url.path().c_str());
+            if (response.content.empty()) { response.error = "File could not be read"; }
+        }
+
+        _callback(response);
+        return 0;
+    }
+};
+
+// Imported URLs are resolved against the absolute path of the scene, make
+// those in its directory relative again.
+static void relativizeUrl(YAML::Node _node, const std::string& _directory) {
+    if (_node && _node.IsScalar() && _node.Scalar().compare(0, _directory.size(), _directory) == 0) {
+        _node = _node.Scalar().substr(_directory.size());
+    }
+}
+
+// Returns _node[_key] without adding the key to _node when it is missing
+static YAML::Node child(const YAML::Node& _node, const char* _key) {
+    return (_node && _node.IsMap()) ? YAML::Node(_node[_key]) : YAML::Node();
+}
+
+// Visits the nodes that Importer::resolveSceneUrls() resolves, other scalars
+// such as names, filter values or functions are kept as they are. Imports
+// are merged into the config and do not remain in it.
+static void relativizeUrls(const YAML::Node& _config, const std::string& _directory) {
+
+    if (auto textures = child(_config, "textures")) {
+        for (const auto& texture : textures) {
+            relativizeUrl(child(texture.second, "url"), _directory);
+        }
+    }
+
+    if (auto styles = child(_config, "styles")) {
+        for (const auto& entry : styles) {
+            auto style = entry.second;
+
+            relativizeUrl(child(style, "texture"), _directory);
+
+            if (auto material = child(style, "material")) {
+                for (auto& prop : {"emission", "ambient", "diffuse", "specular", "normal"}) {
+                    relativizeUrl(child(child(material, prop), "texture"), _directory);
+                }
+            }
+
+            if (auto uniforms = child(child(style, "shaders"), "uniforms")) {
+                for (const auto& uniform : uniforms) {
+                    if (uniform.second.IsSequence()) {
+                        for (const auto& value : uniform.second) { relativizeUrl(value, _directory); }
+                    } else {
+                        relativizeUrl(uniform.second, _directory);
+                    }
+                }
+            }
+        }
+    }
+
+    if (auto sources = child(_config, "sources")) {
+        for (const auto& source : sources) {
+            relativizeUrl(child(source.second, "url"), _directory);
+        }
+    }
+
+    if (auto fonts = child(_config, "fonts")) {
+        for (const auto& font : fonts) {
+            if (font.second.IsSequence()) {
+                for (const auto& face : font.second) { relativizeUrl(child(face, "url"), _directory); }
+            } else {
+                relativizeUrl(child(font.second, "url"), _directory);
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc != 3) {
+        LOGE("Usage: %s <scene.yaml> <scene.tgsb>", argv[0]);
+        return 1;
+    }
+
+    std::string scenePath = argv[1];
+
+    char* absolutePath = realpath(scenePath.c_str(), nullptr);
+    if (!absolutePath) {
+        LOGE("Could not find scene '%s'", scenePath.c_str());
+        return 1;
+    }
+    std::string sceneUrl = absolutePath;
+    std::free(absolutePath);
+    auto directory = sceneUrl.substr(0, sceneUrl.find_last_of('/') + 1);
+
+    auto platform = std::make_shared<FilePlatform>();
+    auto scene = std::make_shared<Scene>(platform, Url(sceneUrl));
+
+    Importer importer(scene);
+    auto config = importer.applySceneImports(platform);
+
+    if (!config || !config.IsMap()) {
+        LOGE("Could not load scene '%s'", scenePath.c_str());
+        return 1;
+    }
+
+    relativizeUrls(config, directory);
+
+    auto data = SceneBinary::write(config);
+
+    std::ofstream out(argv[2], std::ios::binary);
+    out.write(data.data(), data.size());
+
+    if (!out) {
+        LOGE("Could not write '%s'", argv[2]);
+        return 1;
+    }
+
+    LOG("Compiled '%s' into %d bytes", scenePath.c_str(), int(data.size()));
+    return 0;
+}